@@ -13,6 +13,11 @@ MainWindow::MainWindow(QWidget *parent)
     buttonGroup->addButton(ui.btnAllIt);
     buttonGroup->addButton(ui.btnInscIt);
     buttonGroup->addButton(ui.btnCollIt);
+    buttonGroup->addButton(ui.btnInscVis);
+    buttonGroup->addButton(ui.btnCollVis);
+    buttonGroup->addButton(ui.btnLodVis);
+    buttonGroup->addButton(ui.btnInscView);
+    buttonGroup->addButton(ui.btnCollView);
     buttonGroup->setExclusive(true);
 }
 
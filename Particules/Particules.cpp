@@ -33,7 +33,7 @@ Particules::Particules(QWidget* parent)
     r.y1 = urd(dre) * (1.0f - size);
     r.x2 = r.x1 + size;
     r.y2 = r.y1 + size;
-    m_QuadTree.insert(CRect(r.x1, r.y1, r.x2, r.y2));
+    m_QuadTree.emplace(r.x1, r.y1, r.x2, r.y2);
     m_List.push_back(CRect(r.x1, r.y1, r.x2, r.y2));
   }
 
@@ -78,22 +78,25 @@ void Particules::paintEvent(QPaintEvent* event)
     break;
   case Particules::EIterAlgorithm::quadTreeAllFunction:
   {
-    auto rects = m_QuadTree.getAll();
-    for (const auto& rect : rects)
+    m_QueryBuffer.clear();
+    m_QuadTree.getAll(m_QueryBuffer);
+    for (const auto& rect : m_QueryBuffer)
       painter.drawRect(rect);
   }
     break;
   case Particules::EIterAlgorithm::quadTreeFindInscribedFunction:
   {
-    auto rects = m_QuadTree.findInscribed(limits);
-    for (const auto& rect : rects)
+    m_QueryBuffer.clear();
+    m_QuadTree.findInscribed(limits, m_QueryBuffer);
+    for (const auto& rect : m_QueryBuffer)
       painter.drawRect(rect);
   }
     break;
   case Particules::EIterAlgorithm::quadTreeFindCollidingFunction:
   {
-    auto rects = m_QuadTree.findColliding(limits);
-    for (const auto& rect : rects)
+    m_QueryBuffer.clear();
+    m_QuadTree.findColliding(limits, m_QueryBuffer);
+    for (const auto& rect : m_QueryBuffer)
       painter.drawRect(rect);
   }
     break;
@@ -118,6 +121,33 @@ void Particules::paintEvent(QPaintEvent* event)
       painter.drawRect(*it);
   }
     break;
+  case Particules::EIterAlgorithm::quadTreeInscribedVisitor:
+    m_QuadTree.forEachInscribed(limits, [&painter](const CRect& rect) { painter.drawRect(rect); });
+    break;
+  case Particules::EIterAlgorithm::quadTreeCollidingVisitor:
+    m_QuadTree.forEachColliding(limits, [&painter](const CRect& rect) { painter.drawRect(rect); });
+    break;
+  case Particules::EIterAlgorithm::quadTreeLodVisitor:
+  {
+    // Les nœuds plus petits qu'un pixel ne sont dessinés qu'une fois, par leur zone
+    float pixelSize = 1.0f / (side * 0.8f * m_scale);
+    m_QuadTree.forEachCollidingLod(limits, pixelSize,
+      [&painter](const CRect& rect) { painter.drawRect(rect); },
+      [&painter](const TQuadTree<CRect>::SAggregate& aggregate) {
+        const SLimits& l = aggregate.limits;
+        painter.drawRect(QRectF(l.x1, l.y1, l.x2 - l.x1, l.y2 - l.y1));
+      });
+  }
+    break;
+  case Particules::EIterAlgorithm::quadTreeInscribedCachedView:
+    // La vue ne change pas d'une image à l'autre tant qu'on ne zoome pas : le résultat en cache est réutilisé
+    for (const CRect* rect : m_InscribedView.query(m_QuadTree, limits))
+      painter.drawRect(*rect);
+    break;
+  case Particules::EIterAlgorithm::quadTreeCollidingCachedView:
+    for (const CRect* rect : m_CollidingView.query(m_QuadTree, limits))
+      painter.drawRect(*rect);
+    break;
   default:
     break;
   }
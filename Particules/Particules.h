@@ -2,6 +2,7 @@
 
 #include <QtWidgets/QWidget>
 #include "../QuadTree/TQuadTree.h"
+#include "../QuadTree/TViewportQuery.h"
 #include <list>
 #include <queue>
 
@@ -28,6 +29,9 @@ class Particules : public QWidget
 {
   Q_OBJECT
   TQuadTree<CRect> m_QuadTree;
+  TQuadTree<CRect>::container m_QueryBuffer; // Réutilisé d'une image à l'autre par les recherches
+  TViewportQuery<CRect> m_InscribedView{ TViewportQuery<CRect>::EMode::inscribed }; // Recherches de la vue, en cache d'une image à l'autre
+  TViewportQuery<CRect> m_CollidingView{ TViewportQuery<CRect>::EMode::colliding };
   std::list<CRect> m_List;
 #ifdef _DEBUG
   const size_t m_nbParticules = 10000;
@@ -52,7 +56,12 @@ class Particules : public QWidget
     quadTreeFindCollidingFunction,
     quadTreeIterators,
     quadTreeInscribedIterators,
-    quadTreeCollidingIterators
+    quadTreeCollidingIterators,
+    quadTreeInscribedVisitor,
+    quadTreeCollidingVisitor,
+    quadTreeLodVisitor,
+    quadTreeInscribedCachedView,
+    quadTreeCollidingCachedView
   } m_IterAlgorithm;
 
 public:
@@ -73,5 +82,10 @@ public slots:
   void onIterAlgorithmQuadTreeIterators() { m_IterAlgorithm = EIterAlgorithm::quadTreeIterators; update(); }
   void onIterAlgorithmQuadTreeInscribedIterators() { m_IterAlgorithm = EIterAlgorithm::quadTreeInscribedIterators; update(); }
   void onIterAlgorithmQuadTreeCollidingIterators() { m_IterAlgorithm = EIterAlgorithm::quadTreeCollidingIterators; update(); }
+  void onIterAlgorithmQuadTreeInscribedVisitor() { m_IterAlgorithm = EIterAlgorithm::quadTreeInscribedVisitor; update(); }
+  void onIterAlgorithmQuadTreeCollidingVisitor() { m_IterAlgorithm = EIterAlgorithm::quadTreeCollidingVisitor; update(); }
+  void onIterAlgorithmQuadTreeLodVisitor() { m_IterAlgorithm = EIterAlgorithm::quadTreeLodVisitor; update(); }
+  void onIterAlgorithmQuadTreeInscribedCachedView() { m_IterAlgorithm = EIterAlgorithm::quadTreeInscribedCachedView; update(); }
+  void onIterAlgorithmQuadTreeCollidingCachedView() { m_IterAlgorithm = EIterAlgorithm::quadTreeCollidingCachedView; update(); }
 
 };
@@ -0,0 +1,148 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <utility>
+
+/**
+ * @brief Tableau de rectangles englobants stocké en "structure de tableaux".
+ *
+ * Les coordonnées x1, y1, x2 et y2 des rectangles sont rangées dans 4 voies de flottants contiguës,
+ * allouées en un seul bloc aligné : un filtre (chevauchement, inclusion) parcourt ainsi des flottants
+ * compacts sans toucher aux données associées.
+ *
+ * La capacité est toujours un multiple de LANE_WIDTH et chaque voie est alignée sur ALIGNMENT octets :
+ * une voie se découpe en paquets de 4 flottants (un registre SSE), le premier bloc alloué tenant dans
+ * une ligne de cache.
+ */
+class CBoundsArray
+{
+public:
+    static constexpr std::size_t LANE_WIDTH = 4;   ///< Granularité de la capacité (un registre SSE de flottants)
+    static constexpr std::size_t ALIGNMENT = 16;   ///< Alignement en octets de chaque voie
+
+private:
+    float* m_data = nullptr;        ///< 4 voies de m_capacity flottants : x1 | y1 | x2 | y2
+    std::uint32_t m_size = 0;       ///< Nombre de rectangles stockés
+    std::uint32_t m_capacity = 0;   ///< Nombre de rectangles allouables sans réallocation
+
+    static float* allocate(std::size_t capacity)
+    {
+        return static_cast<float*>(::operator new(4 * capacity * sizeof(float), std::align_val_t{ ALIGNMENT }));
+    }
+
+    static void deallocate(float* data) noexcept
+    {
+        if (data) {
+            ::operator delete(data, std::align_val_t{ ALIGNMENT });
+        }
+    }
+
+    /**
+     * @brief Réalloue les 4 voies avec la capacité donnée (multiple de LANE_WIDTH, >= m_size).
+     */
+    void reallocate(std::size_t capacity)
+    {
+        float* data = allocate(capacity);
+        for (std::size_t lane = 0; lane < 4; ++lane) {
+            if (m_size) {
+                std::memcpy(data + lane * capacity, m_data + lane * m_capacity, m_size * sizeof(float));
+            }
+        }
+        deallocate(m_data);
+        m_data = data;
+        m_capacity = static_cast<std::uint32_t>(capacity);
+    }
+
+public:
+    CBoundsArray() noexcept = default;
+
+    CBoundsArray(const CBoundsArray& other)
+    {
+        if (other.m_size) {
+            reallocate(other.m_capacity);
+            for (std::size_t lane = 0; lane < 4; ++lane) {
+                std::memcpy(m_data + lane * m_capacity, other.m_data + lane * other.m_capacity, other.m_size * sizeof(float));
+            }
+            m_size = other.m_size;
+        }
+    }
+
+    CBoundsArray(CBoundsArray&& other) noexcept
+        : m_data(std::exchange(other.m_data, nullptr)),
+        m_size(std::exchange(other.m_size, 0)),
+        m_capacity(std::exchange(other.m_capacity, 0))
+    {
+    }
+
+    CBoundsArray& operator=(CBoundsArray other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+
+    ~CBoundsArray()
+    {
+        deallocate(m_data);
+    }
+
+    void swap(CBoundsArray& other) noexcept
+    {
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+        std::swap(m_capacity, other.m_capacity);
+    }
+
+    std::size_t size() const noexcept { return m_size; }
+    bool empty() const noexcept { return m_size == 0; }
+
+    const float* x1() const noexcept { return m_data; }
+    const float* y1() const noexcept { return m_data + m_capacity; }
+    const float* x2() const noexcept { return m_data + 2 * std::size_t(m_capacity); }
+    const float* y2() const noexcept { return m_data + 3 * std::size_t(m_capacity); }
+
+    /**
+     * @brief Réserve la place pour au moins n rectangles.
+     */
+    void reserve(std::size_t n)
+    {
+        if (n > m_capacity) {
+            reallocate((n + LANE_WIDTH - 1) / LANE_WIDTH * LANE_WIDTH);
+        }
+    }
+
+    /**
+     * @brief Ajoute un rectangle à la fin du tableau.
+     */
+    void push_back(float x1, float y1, float x2, float y2)
+    {
+        if (m_size == m_capacity) {
+            reallocate(m_capacity ? 2 * std::size_t(m_capacity) : LANE_WIDTH);
+        }
+        m_data[m_size] = x1;
+        m_data[m_capacity + m_size] = y1;
+        m_data[2 * std::size_t(m_capacity) + m_size] = x2;
+        m_data[3 * std::size_t(m_capacity) + m_size] = y2;
+        ++m_size;
+    }
+
+    /**
+     * @brief Retire le rectangle i en le remplaçant par le dernier (l'ordre n'est pas conservé).
+     */
+    void eraseSwap(std::size_t i) noexcept
+    {
+        const std::size_t last = --m_size;
+        for (std::size_t lane = 0; lane < 4; ++lane) {
+            m_data[lane * m_capacity + i] = m_data[lane * m_capacity + last];
+        }
+    }
+
+    /**
+     * @brief Vide le tableau en conservant la mémoire allouée.
+     */
+    void clear() noexcept
+    {
+        m_size = 0;
+    }
+};
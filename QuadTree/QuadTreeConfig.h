@@ -0,0 +1,35 @@
+#pragma once
+#include <cstddef>
+
+/**
+ * @brief Critère déclenchant la subdivision d'une feuille lors d'une insertion.
+ */
+enum class ESplitTrigger
+{
+    eagerFit,       ///< Subdivise si la capacité est dépassée ou dès qu'un élément tient dans un enfant (comportement historique)
+    countThreshold, ///< Subdivise uniquement si la capacité est dépassée
+    areaRatio       ///< Subdivise si la capacité est dépassée ou si un élément tenant dans un enfant est petit devant le nœud
+};
+
+/**
+ * @brief Paramètres de subdivision d'un TQuadTree.
+ *
+ * La configuration par défaut reproduit le comportement historique : une feuille ne garde qu'un élément
+ * et se subdivise dès qu'un élément peut descendre d'un niveau.
+ *
+ * Avec looseness > 1, chaque nœud accepte les éléments contenus dans ses limites élargies autour de son centre :
+ * un élément chevauchant une médiane peut alors descendre tant qu'il est petit devant le nœud,
+ * au lieu de rester dans les nœuds du haut.
+ *
+ * Un mergeThreshold > 0 se combine surtout avec ESplitTrigger::countThreshold : avec eagerFit, les éléments
+ * regroupés dans un nœud y restent jusqu'à la prochaine insertion qui le subdivise de nouveau.
+ */
+struct SQuadTreeConfig
+{
+    std::size_t capacity = 1;                      ///< Nombre max. d'éléments dans une feuille avant subdivision
+    std::size_t maxDepth = 64;                     ///< Profondeur maximale (la racine est au niveau 1)
+    ESplitTrigger trigger = ESplitTrigger::eagerFit; ///< Critère de subdivision
+    float areaRatio = 0.0625f;                     ///< Pour ESplitTrigger::areaRatio : aire max. d'un élément, relative au nœud, pour provoquer la subdivision, dans ]0, 1]
+    float looseness = 1.0f;                        ///< Facteur d'élargissement des nœuds (loose quadtree), >= 1 : 1 pour un QuadTree classique, 2 en usage courant
+    std::size_t mergeThreshold = 0;                ///< remove() ramène dans un nœud les éléments de ses descendants dès qu'ils sont au plus ce nombre (0 : élague seulement les branches vides)
+};
@@ -0,0 +1,298 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "QuadTreeBounds.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define QUADTREE_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+//MSVC accepte les intrinsèques AVX sans option de compilation, GCC et Clang demandent un attribut par fonction
+#if defined(QUADTREE_SIMD_X86) && !defined(_MSC_VER)
+#define QUADTREE_TARGET(isa) __attribute__((target(isa)))
+#else
+#define QUADTREE_TARGET(isa)
+#endif
+
+/**
+ * @brief Jeu d'instructions utilisé par les filtres de CBoxFilter.
+ */
+enum class EInstructionSet
+{
+    scalar, ///< Implémentation portable, sans vectorisation
+    sse,    ///< 4 rectangles par comparaison
+    avx2,   ///< 8 rectangles par comparaison
+    avx512  ///< 16 rectangles par comparaison
+};
+
+/**
+ * @brief Filtres vectoriels testant un paquet de rectangles (CBoundsArray) contre une zone de recherche.
+ *
+ * Chaque filtre traite au plus 64 rectangles et retourne un masque dont le bit i vaut 1 si le rectangle
+ * first + i satisfait le test. Le jeu d'instructions est choisi à l'exécution selon le processeur
+ * (AVX-512, AVX2, SSE), avec un repli scalaire sur les autres architectures.
+ *
+ * Les noyaux lisent les voies par paquets de 4 flottants : ils s'appuient sur la capacité de CBoundsArray,
+ * toujours multiple de CBoundsArray::LANE_WIDTH, et ignorent les valeurs lues au-delà de size().
+ */
+class CBoxFilter
+{
+public:
+    static constexpr std::size_t BATCH = 64; ///< Nombre max. de rectangles testés par appel
+
+private:
+    /**
+     * @brief Noyau de filtrage : bit i = (geX[i] >= minX && geY[i] >= minY && leX[i] <= maxX && leY[i] <= maxY).
+     *
+     * Les deux tests (chevauchement, inclusion) se ramènent à cette forme en permutant les voies.
+     */
+    using Kernel = std::uint64_t(*)(const float* geX, const float* geY, const float* leX, const float* leY,
+        std::size_t count, float minX, float minY, float maxX, float maxY);
+
+    static std::uint64_t lowBits(std::size_t count) noexcept
+    {
+        return count >= 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << count) - 1;
+    }
+
+    static std::uint64_t kernelScalar(const float* geX, const float* geY, const float* leX, const float* leY,
+        std::size_t count, float minX, float minY, float maxX, float maxY) noexcept
+    {
+        std::uint64_t mask = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            const bool match = (geX[i] >= minX) & (geY[i] >= minY) & (leX[i] <= maxX) & (leY[i] <= maxY);
+            mask |= std::uint64_t(match) << i;
+        }
+        return mask;
+    }
+
+#ifdef QUADTREE_SIMD_X86
+    static std::uint64_t kernelSse(const float* geX, const float* geY, const float* leX, const float* leY,
+        std::size_t count, float minX, float minY, float maxX, float maxY) noexcept
+    {
+        const __m128 qMinX = _mm_set1_ps(minX);
+        const __m128 qMinY = _mm_set1_ps(minY);
+        const __m128 qMaxX = _mm_set1_ps(maxX);
+        const __m128 qMaxY = _mm_set1_ps(maxY);
+        std::uint64_t mask = 0;
+        for (std::size_t i = 0; i < count; i += 4) {
+            __m128 m = _mm_cmpge_ps(_mm_load_ps(geX + i), qMinX);
+            m = _mm_and_ps(m, _mm_cmpge_ps(_mm_load_ps(geY + i), qMinY));
+            m = _mm_and_ps(m, _mm_cmple_ps(_mm_load_ps(leX + i), qMaxX));
+            m = _mm_and_ps(m, _mm_cmple_ps(_mm_load_ps(leY + i), qMaxY));
+            mask |= std::uint64_t(_mm_movemask_ps(m)) << i;
+        }
+        return mask & lowBits(count);
+    }
+
+    QUADTREE_TARGET("avx2")
+    static std::uint64_t kernelAvx2(const float* geX, const float* geY, const float* leX, const float* leY,
+        std::size_t count, float minX, float minY, float maxX, float maxY) noexcept
+    {
+        const __m256 qMinX = _mm256_set1_ps(minX);
+        const __m256 qMinY = _mm256_set1_ps(minY);
+        const __m256 qMaxX = _mm256_set1_ps(maxX);
+        const __m256 qMaxY = _mm256_set1_ps(maxY);
+        std::uint64_t mask = 0;
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m256 m = _mm256_cmp_ps(_mm256_loadu_ps(geX + i), qMinX, _CMP_GE_OQ);
+            m = _mm256_and_ps(m, _mm256_cmp_ps(_mm256_loadu_ps(geY + i), qMinY, _CMP_GE_OQ));
+            m = _mm256_and_ps(m, _mm256_cmp_ps(_mm256_loadu_ps(leX + i), qMaxX, _CMP_LE_OQ));
+            m = _mm256_and_ps(m, _mm256_cmp_ps(_mm256_loadu_ps(leY + i), qMaxY, _CMP_LE_OQ));
+            mask |= std::uint64_t(_mm256_movemask_ps(m)) << i;
+        }
+        // Reste : un paquet de 4 (la capacité est multiple de 4, pas forcément de 8)
+        for (; i < count; i += 4) {
+            __m128 m = _mm_cmp_ps(_mm_load_ps(geX + i), _mm256_castps256_ps128(qMinX), _CMP_GE_OQ);
+            m = _mm_and_ps(m, _mm_cmp_ps(_mm_load_ps(geY + i), _mm256_castps256_ps128(qMinY), _CMP_GE_OQ));
+            m = _mm_and_ps(m, _mm_cmp_ps(_mm_load_ps(leX + i), _mm256_castps256_ps128(qMaxX), _CMP_LE_OQ));
+            m = _mm_and_ps(m, _mm_cmp_ps(_mm_load_ps(leY + i), _mm256_castps256_ps128(qMaxY), _CMP_LE_OQ));
+            mask |= std::uint64_t(_mm_movemask_ps(m)) << i;
+        }
+        return mask & lowBits(count);
+    }
+
+    QUADTREE_TARGET("avx512f")
+    static std::uint64_t kernelAvx512(const float* geX, const float* geY, const float* leX, const float* leY,
+        std::size_t count, float minX, float minY, float maxX, float maxY) noexcept
+    {
+        const __m512 qMinX = _mm512_set1_ps(minX);
+        const __m512 qMinY = _mm512_set1_ps(minY);
+        const __m512 qMaxX = _mm512_set1_ps(maxX);
+        const __m512 qMaxY = _mm512_set1_ps(maxY);
+        std::uint64_t mask = 0;
+        for (std::size_t i = 0; i < count; i += 16) {
+            // Chargement masqué : aucune lecture au-delà de count
+            const __mmask16 valid = static_cast<__mmask16>(lowBits(std::min<std::size_t>(16, count - i)));
+            __mmask16 m = _mm512_mask_cmp_ps_mask(valid, _mm512_maskz_loadu_ps(valid, geX + i), qMinX, _CMP_GE_OQ);
+            m = _mm512_mask_cmp_ps_mask(m, _mm512_maskz_loadu_ps(valid, geY + i), qMinY, _CMP_GE_OQ);
+            m = _mm512_mask_cmp_ps_mask(m, _mm512_maskz_loadu_ps(valid, leX + i), qMaxX, _CMP_LE_OQ);
+            m = _mm512_mask_cmp_ps_mask(m, _mm512_maskz_loadu_ps(valid, leY + i), qMaxY, _CMP_LE_OQ);
+            mask |= std::uint64_t(m) << i;
+        }
+        return mask;
+    }
+
+    /**
+     * @brief Détecte le meilleur jeu d'instructions supporté par le processeur et le système.
+     */
+    static EInstructionSet detect() noexcept
+    {
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        const int maxLeaf = info[0];
+        __cpuid(info, 1);
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        const bool avx = (info[2] & (1 << 28)) != 0;
+        if (!osxsave || !avx || maxLeaf < 7) {
+            return EInstructionSet::sse;
+        }
+        const unsigned long long xcr0 = _xgetbv(0);
+        __cpuidex(info, 7, 0);
+        const bool ymm = (xcr0 & 0x6) == 0x6;
+        const bool zmm = (xcr0 & 0xE6) == 0xE6;
+        if (zmm && (info[1] & (1 << 16))) {
+            return EInstructionSet::avx512;
+        }
+        if (ymm && (info[1] & (1 << 5))) {
+            return EInstructionSet::avx2;
+        }
+        return EInstructionSet::sse;
+#else
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) {
+            return EInstructionSet::avx512;
+        }
+        if (__builtin_cpu_supports("avx2")) {
+            return EInstructionSet::avx2;
+        }
+        return EInstructionSet::sse;
+#endif
+    }
+#else
+    static EInstructionSet detect() noexcept
+    {
+        return EInstructionSet::scalar;
+    }
+#endif
+
+    static Kernel kernelFor(EInstructionSet isa) noexcept
+    {
+        switch (isa) {
+#ifdef QUADTREE_SIMD_X86
+        case EInstructionSet::avx512:
+            return &kernelAvx512;
+        case EInstructionSet::avx2:
+            return &kernelAvx2;
+        case EInstructionSet::sse:
+            return &kernelSse;
+#endif
+        default:
+            return &kernelScalar;
+        }
+    }
+
+    /**
+     * @brief État de la sélection du noyau, initialisé au premier filtrage.
+     */
+    struct SDispatch
+    {
+        EInstructionSet supported;  ///< Meilleur jeu d'instructions disponible
+        EInstructionSet current;    ///< Jeu d'instructions utilisé
+        Kernel kernel;              ///< Noyau correspondant à current
+    };
+
+    static SDispatch& dispatch() noexcept
+    {
+        static SDispatch s_dispatch = [] {
+            const EInstructionSet isa = detect();
+            return SDispatch{ isa, isa, kernelFor(isa) };
+        }();
+        return s_dispatch;
+    }
+
+public:
+    /**
+     * @brief Retourne le jeu d'instructions utilisé par les filtres.
+     */
+    static EInstructionSet instructionSet() noexcept
+    {
+        return dispatch().current;
+    }
+
+    /**
+     * @brief Retourne le meilleur jeu d'instructions disponible sur cette machine.
+     */
+    static EInstructionSet supportedInstructionSet() noexcept
+    {
+        return dispatch().supported;
+    }
+
+    /**
+     * @brief Force le jeu d'instructions utilisé (pour comparer les noyaux entre eux).
+     *
+     * Un jeu non supporté par la machine est ramené au meilleur jeu disponible.
+     * Cette fonction n'est pas thread-safe : à appeler avant toute recherche concurrente.
+     */
+    static void setInstructionSet(EInstructionSet isa) noexcept
+    {
+        SDispatch& d = dispatch();
+        d.current = std::min(isa, d.supported);
+        d.kernel = kernelFor(d.current);
+    }
+
+    /**
+     * @brief Masque des rectangles [first, first + count) qui chevauchent la zone (minX, minY, maxX, maxY).
+     *
+     * @param first Premier rectangle testé, multiple de CBoundsArray::LANE_WIDTH.
+     * @param count Nombre de rectangles testés, au plus BATCH.
+     */
+    static std::uint64_t overlapMask(const CBoundsArray& b, std::size_t first, std::size_t count,
+        float minX, float minY, float maxX, float maxY) noexcept
+    {
+        return dispatch().kernel(b.x2() + first, b.y2() + first, b.x1() + first, b.y1() + first, count, minX, minY, maxX, maxY);
+    }
+
+    /**
+     * @brief Masque des rectangles [first, first + count) entièrement inclus dans la zone (minX, minY, maxX, maxY).
+     *
+     * @param first Premier rectangle testé, multiple de CBoundsArray::LANE_WIDTH.
+     * @param count Nombre de rectangles testés, au plus BATCH.
+     */
+    static std::uint64_t insideMask(const CBoundsArray& b, std::size_t first, std::size_t count,
+        float minX, float minY, float maxX, float maxY) noexcept
+    {
+        return dispatch().kernel(b.x1() + first, b.y1() + first, b.x2() + first, b.y2() + first, count, minX, minY, maxX, maxY);
+    }
+
+    /**
+     * @brief Appelle f(i) pour chaque bit i à 1 de mask, dans l'ordre croissant.
+     *
+     * Si f retourne un booléen, le parcours s'arrête dès qu'il vaut false.
+     *
+     * @return false si le parcours a été interrompu par f.
+     */
+    template<typename F>
+    static bool forEachBit(std::uint64_t mask, std::size_t first, F&& f)
+    {
+        while (mask) {
+            const std::size_t i = first + static_cast<std::size_t>(std::countr_zero(mask));
+            if constexpr (std::is_void_v<std::invoke_result_t<F&, std::size_t>>) {
+                f(i);
+            }
+            else if (!f(i)) {
+                return false;
+            }
+            mask &= mask - 1;
+        }
+        return true;
+    }
+};
@@ -0,0 +1,115 @@
+#pragma once
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Réserve d'éléments découpée en blocs de taille fixe, indexée comme un tableau.
+ *
+ * Contrairement à un std::vector unique, l'ajout d'un élément ne déplace jamais les éléments déjà rangés :
+ * un bloc plein est complété par un nouveau bloc de CHUNK_SIZE éléments. Les blocs restent de taille modeste,
+ * l'allocateur peut donc réutiliser la mémoire libérée au lieu de demander au système un bloc géant
+ * à chaque construction ou copie.
+ *
+ * @tparam T Le type des éléments stockés.
+ */
+template<typename T>
+class TItemSlab
+{
+public:
+    static constexpr std::size_t CHUNK_SHIFT = 10;                          ///< log2 du nombre d'éléments par bloc
+    static constexpr std::size_t CHUNK_SIZE = std::size_t(1) << CHUNK_SHIFT; ///< Nombre d'éléments par bloc
+
+private:
+    std::vector<std::vector<T>> m_chunks;   ///< Blocs d'au plus CHUNK_SIZE éléments (les blocs vidés par clear() sont gardés)
+    std::size_t m_size = 0;                 ///< Nombre d'éléments stockés
+
+public:
+    TItemSlab() noexcept = default;
+
+    /**
+     * @brief Constructeur de copie : chaque bloc copié reçoit sa capacité complète, pour que les ajouts suivants
+     *        ne le réallouent pas (et ne déplacent donc pas ses éléments).
+     */
+    TItemSlab(const TItemSlab& other)
+        : m_size(other.m_size)
+    {
+        m_chunks.reserve((m_size + CHUNK_SIZE - 1) >> CHUNK_SHIFT);
+        for (const std::vector<T>& c : other.m_chunks) {
+            if (c.empty()) {
+                break; // Les blocs vidés par clear() ne sont pas copiés
+            }
+            std::vector<T>& copy = m_chunks.emplace_back();
+            copy.reserve(CHUNK_SIZE);
+            copy.insert(copy.end(), c.begin(), c.end());
+        }
+    }
+
+    TItemSlab(TItemSlab&& other) noexcept
+        : m_chunks(std::move(other.m_chunks)),
+        m_size(std::exchange(other.m_size, 0))
+    {
+        other.m_chunks.clear();
+    }
+
+    TItemSlab& operator=(TItemSlab other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+
+    void swap(TItemSlab& other) noexcept
+    {
+        m_chunks.swap(other.m_chunks);
+        std::swap(m_size, other.m_size);
+    }
+
+    std::size_t size() const noexcept { return m_size; }
+    bool empty() const noexcept { return m_size == 0; }
+
+    T& operator[](std::size_t i) noexcept { return m_chunks[i >> CHUNK_SHIFT][i & (CHUNK_SIZE - 1)]; }
+    const T& operator[](std::size_t i) const noexcept { return m_chunks[i >> CHUNK_SHIFT][i & (CHUNK_SIZE - 1)]; }
+
+    /**
+     * @brief Réserve la table des blocs pour au moins n éléments (les blocs eux-mêmes sont alloués au besoin).
+     */
+    void reserve(std::size_t n)
+    {
+        m_chunks.reserve((n + CHUNK_SIZE - 1) >> CHUNK_SHIFT);
+    }
+
+    /**
+     * @brief Construit un élément à la fin de la réserve.
+     *
+     * @return L'élément construit. En cas d'exception, la réserve est inchangée.
+     */
+    template<typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        const std::size_t chunk = m_size >> CHUNK_SHIFT;
+        if (chunk == m_chunks.size()) {
+            m_chunks.emplace_back();
+        }
+        std::vector<T>& c = m_chunks[chunk];
+        if (c.capacity() == 0) {
+            c.reserve(CHUNK_SIZE);
+        }
+        T& t = c.emplace_back(std::forward<Args>(args)...);
+        ++m_size;
+        return t;
+    }
+
+    void push_back(const T& t) { emplace_back(t); }
+    void push_back(T&& t) { emplace_back(std::move(t)); }
+
+    /**
+     * @brief Vide la réserve en conservant les blocs alloués pour les ajouts suivants.
+     */
+    void clear() noexcept
+    {
+        for (std::vector<T>& c : m_chunks) {
+            c.clear();
+        }
+        m_size = 0;
+    }
+};
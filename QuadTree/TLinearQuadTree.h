@@ -0,0 +1,590 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <numeric>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include "TQuadTree.h"
+
+/**
+ * @brief QuadTree linéaire : variante de TQuadTree sans nœuds ni pointeurs.
+ *
+ * Chaque élément est associé au plus petit quadrant qui le contient entièrement (le nœud où TQuadTree le rangerait),
+ * identifié par une clé de Morton (ordre Z). Les éléments sont stockés dans des tableaux contigus triés par clé :
+ * le sous-arbre d'un quadrant occupe alors une plage contiguë, et une recherche devient une suite de parcours de plages.
+ *
+ * Les méthodes insert, remove, findColliding, findInscribed, getAll et les itérateurs s'utilisent comme celles
+ * de TQuadTree. Les insertions sont accumulées et les retraits seulement marqués : la première lecture qui suit
+ * les applique en une passe (tri des éléments en attente, fusion et compactage). Cette mise à jour est protégée
+ * par un verrou : comme pour TQuadTree, des lectures peuvent être concurrentes entre elles, mais pas avec
+ * une modification.
+ *
+ * @tparam T Le type des données à stocker.
+ * T doit respecter le concept QuadTreeData.
+ */
+template <QuadTreeData T>
+class TLinearQuadTree
+{
+public:
+    using container = std::vector<T>;
+
+    /**
+     * @brief Niveau maximal d'un quadrant (la racine est au niveau 0).
+     *
+     * Au-delà de 24 subdivisions, la largeur d'un quadrant de [0, 1] descend sous la précision d'un float.
+     */
+    static constexpr unsigned MAX_LEVEL = 24;
+
+private:
+    static constexpr unsigned LEVEL_BITS = 5; ///< Bits de poids faible de la clé réservés au niveau
+
+    /**
+     * @brief Clé d'un quadrant : préfixe de Morton aligné sur MAX_LEVEL, suivi du niveau.
+     *
+     * Un quadrant précède ainsi tous ses descendants, eux-mêmes contigus dans l'ordre des clés.
+     */
+    static std::uint64_t makeKey(std::uint64_t prefix, unsigned level) noexcept
+    {
+        return (prefix << LEVEL_BITS) | level;
+    }
+
+    /**
+     * @brief Nombre de préfixes (alignés sur MAX_LEVEL) couverts par un quadrant du niveau donné.
+     */
+    static std::uint64_t prefixSpan(unsigned level) noexcept
+    {
+        return std::uint64_t(1) << (2 * (MAX_LEVEL - level));
+    }
+
+    static bool isFullyInside(const SLimits& itemBounds, const SLimits& searchLimits) noexcept
+    {
+        return itemBounds.x1 >= searchLimits.x1 &&
+            itemBounds.y1 >= searchLimits.y1 &&
+            itemBounds.x2 <= searchLimits.x2 &&
+            itemBounds.y2 <= searchLimits.y2;
+    }
+
+    static bool overlap(const SLimits& a, const SLimits& b) noexcept
+    {
+        return !(b.x1 > a.x2 || b.x2 < a.x1 || b.y1 > a.y2 || b.y2 < a.y1);
+    }
+
+    static SLimits boundsOf(const T& t) noexcept
+    {
+        return { t.x1(), t.y1(), t.x2(), t.y2() };
+    }
+
+    /**
+     * @brief Limites du quadrant c (NO, NE, SO, SE) d'une zone, calculées comme dans TQuadTree::subdivide.
+     */
+    static SLimits quadrant(const SLimits& l, unsigned c) noexcept
+    {
+        float midX = (l.x1 + l.x2) * 0.5f;
+        float midY = (l.y1 + l.y2) * 0.5f;
+        switch (c) {
+        case 0: return { l.x1, l.y1, midX, midY };  // NW
+        case 1: return { midX, l.y1, l.x2, midY };  // NE
+        case 2: return { l.x1, midY, midX, l.y2 };  // SW
+        default: return { midX, midY, l.x2, l.y2 }; // SE
+        }
+    }
+
+    /**
+     * @brief Indicateur et verrou de l'application des modifications en attente par une lecture.
+     *
+     * Le verrou n'est pas copié : une copie de l'arbre a le sien.
+     */
+    struct SCommitState
+    {
+        std::mutex mutex;
+        std::atomic<bool> dirty{ false };   ///< Des modifications attendent commit()
+
+        SCommitState() = default;
+        SCommitState(const SCommitState& other) noexcept
+            : dirty(other.dirty.load(std::memory_order_relaxed))
+        {}
+        SCommitState& operator=(const SCommitState& other) noexcept
+        {
+            dirty.store(other.dirty.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            return *this;
+        }
+    };
+
+    // Les tableaux sont modifiés par commit(), appelée sous verrou par les lectures
+    SLimits _limits;
+    mutable std::vector<std::uint64_t> m_keys;          ///< Clés triées
+    mutable container m_data;                           ///< Éléments, dans l'ordre des clés
+    mutable CBoundsArray m_bounds;                      ///< Limites des éléments, dans l'ordre des clés
+    mutable std::vector<std::uint64_t> m_pendingKeys;   ///< Clés des éléments insérés depuis le dernier commit()
+    mutable container m_pending;                        ///< Éléments insérés depuis le dernier commit()
+    mutable std::vector<std::uint8_t> m_removed;        ///< Marques des éléments de m_data retirés (vide s'il n'y en a aucun)
+    mutable std::size_t m_removedCount = 0;             ///< Nombre d'éléments marqués dans m_removed
+    std::size_t m_size = 0;                             ///< Nombre d'éléments, modifications en attente comprises
+    mutable SCommitState m_commit;
+
+    /**
+     * @brief Clé du plus petit quadrant contenant entièrement r.
+     */
+    std::uint64_t keyOf(const SLimits& r) const noexcept
+    {
+        SLimits l = _limits;
+        std::uint64_t code = 0;
+        unsigned level = 0;
+        while (level < MAX_LEVEL) {
+            unsigned c = 0;
+            while (c < 4 && !isFullyInside(r, quadrant(l, c))) {
+                ++c;
+            }
+            if (c == 4) {
+                break;
+            }
+            l = quadrant(l, c);
+            code = (code << 2) | c;
+            ++level;
+        }
+        return makeKey(code << (2 * (MAX_LEVEL - level)), level);
+    }
+
+    /**
+     * @brief Applique les modifications en attente avant une lecture, une seule fois même si plusieurs lectures
+     *        concurrentes la demandent.
+     */
+    void applyPending() const
+    {
+        if (!m_commit.dirty.load(std::memory_order_acquire)) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(m_commit.mutex);
+        if (m_commit.dirty.load(std::memory_order_relaxed)) {
+            commit();
+            m_commit.dirty.store(false, std::memory_order_release);
+        }
+    }
+
+    /**
+     * @brief Applique les modifications en attente : trie les éléments insérés, les fusionne dans les tableaux triés
+     *        et en retire les éléments marqués par remove(), en une seule passe.
+     */
+    void commit() const
+    {
+        if (m_pending.empty() && m_removedCount == 0) {
+            return;
+        }
+
+        // Tri stable des éléments en attente : à clé égale, l'ordre d'insertion est conservé
+        std::vector<std::uint32_t> order(m_pending.size());
+        std::iota(order.begin(), order.end(), 0u);
+        std::stable_sort(order.begin(), order.end(),
+            [this](std::uint32_t a, std::uint32_t b) { return m_pendingKeys[a] < m_pendingKeys[b]; });
+
+        // Fusion des deux suites triées, sans les éléments retirés
+        const std::size_t total = m_data.size() - m_removedCount + m_pending.size();
+        std::vector<std::uint64_t> keys;
+        container data;
+        CBoundsArray bounds;
+        keys.reserve(total);
+        data.reserve(total);
+        bounds.reserve(total);
+        auto push = [&](std::uint64_t key, T& item) {
+            SLimits r = boundsOf(item);
+            keys.push_back(key);
+            data.push_back(std::move(item));
+            bounds.push_back(r.x1, r.y1, r.x2, r.y2);
+        };
+        auto pushKept = [&](std::size_t i) {
+            if (m_removed.empty() || !m_removed[i]) {
+                push(m_keys[i], m_data[i]);
+            }
+        };
+        std::size_t i = 0;
+        for (std::uint32_t p : order) {
+            while (i < m_data.size() && m_keys[i] <= m_pendingKeys[p]) {
+                pushKept(i);
+                ++i;
+            }
+            push(m_pendingKeys[p], m_pending[p]);
+        }
+        for (; i < m_data.size(); ++i) {
+            pushKept(i);
+        }
+
+        m_keys.swap(keys);
+        m_data.swap(data);
+        m_bounds.swap(bounds);
+        m_pendingKeys.clear();
+        m_pending.clear();
+        m_removed.clear();
+        m_removedCount = 0;
+    }
+
+    /**
+     * @brief Parcourt le sous-arbre du quadrant (prefix, level), de limites l, dont les éléments occupent [lo, hi).
+     *
+     * @param inscribed true pour les éléments inclus dans q, false pour ceux en collision avec q.
+     * @param f Appelée avec la position de chaque élément retenu.
+     */
+    template<typename F>
+    void query(std::uint64_t prefix, unsigned level, const SLimits& l, std::size_t lo, std::size_t hi,
+        const SLimits& q, bool inscribed, F& f) const
+    {
+        if (lo == hi || !overlap(l, q)) {
+            return;
+        }
+
+        // Quadrant entièrement dans la zone : tout son sous-arbre est retenu, sans test
+        if (isFullyInside(l, q)) {
+            for (std::size_t i = lo; i < hi; ++i) {
+                f(i);
+            }
+            return;
+        }
+
+        // Éléments propres au quadrant : en tête de plage, filtrés par paquets alignés
+        const std::uint64_t ownKey = makeKey(prefix, level);
+        std::size_t i = lo;
+        while (i < hi && m_keys[i] == ownKey) {
+            ++i;
+        }
+        for (std::size_t first = lo & ~(CBoundsArray::LANE_WIDTH - 1); first < i; first += CBoxFilter::BATCH) {
+            const std::size_t count = std::min(CBoxFilter::BATCH, i - first);
+            std::uint64_t mask = inscribed
+                ? CBoxFilter::insideMask(m_bounds, first, count, q.x1, q.y1, q.x2, q.y2)
+                : CBoxFilter::overlapMask(m_bounds, first, count, q.x1, q.y1, q.x2, q.y2);
+            if (first < lo) {
+                mask &= ~std::uint64_t(0) << (lo - first);
+            }
+            CBoxFilter::forEachBit(mask, first, f);
+        }
+        if (level == MAX_LEVEL) {
+            return;
+        }
+
+        // Découpe le reste de la plage entre les 4 quadrants enfants
+        const std::uint64_t span = prefixSpan(level + 1);
+        for (unsigned c = 0; c < 4 && i < hi; ++c) {
+            const std::uint64_t childPrefix = prefix + c * span;
+            const std::uint64_t childEnd = makeKey(childPrefix + span, 0);
+            const std::size_t end = static_cast<std::size_t>(
+                std::lower_bound(m_keys.begin() + i, m_keys.begin() + hi, childEnd) - m_keys.begin());
+            query(childPrefix, level + 1, quadrant(l, c), i, end, q, inscribed, f);
+            i = end;
+        }
+    }
+
+    /**
+     * @brief Positions (dans les tableaux triés) des éléments retenus par une recherche.
+     */
+    std::vector<std::uint32_t> positions(const SLimits& q, bool inscribed) const
+    {
+        applyPending();
+        std::vector<std::uint32_t> result;
+        auto collect = [&result](std::size_t i) { result.push_back(static_cast<std::uint32_t>(i)); };
+        query(0, 0, _limits, 0, m_data.size(), q, inscribed, collect);
+        return result;
+    }
+
+public:
+    /**
+     * @brief Itérateur pour parcourir les éléments du QuadTree linéaire.
+     *
+     * Le parcours de tous les éléments suit directement les tableaux triés ; une recherche mémorise
+     * seulement les positions des éléments retenus. L'itérateur est invalidé par toute modification de l'arbre.
+     */
+    class iterator {
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = T;
+        using pointer = T*;
+        using reference = T&;
+        using iterator_category = std::input_iterator_tag;
+
+    private:
+        const TLinearQuadTree* m_tree = nullptr;                         ///< nullptr pour l'itérateur de fin
+        std::shared_ptr<const std::vector<std::uint32_t>> m_positions;   ///< nullptr pour un parcours complet
+        std::size_t m_index = 0;
+
+        std::size_t count() const noexcept
+        {
+            return m_positions ? m_positions->size() : m_tree->m_data.size();
+        }
+
+    public:
+        iterator() = default;
+        iterator(const TLinearQuadTree* tree, std::shared_ptr<const std::vector<std::uint32_t>> positions)
+            : m_tree(tree), m_positions(std::move(positions))
+        {
+            if (count() == 0) {
+                m_tree = nullptr;
+            }
+        }
+
+        bool operator==(const iterator& other) const
+        {
+            if (!m_tree || !other.m_tree) {
+                return m_tree == other.m_tree;
+            }
+            return m_positions == other.m_positions && m_index == other.m_index;
+        }
+
+        bool operator!=(const iterator& other) const
+        {
+            return !(*this == other);
+        }
+
+        iterator& operator++()
+        {
+            if (m_tree && ++m_index >= count()) {
+                m_tree = nullptr;
+                m_positions.reset();
+                m_index = 0;
+            }
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            iterator temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        const T& operator*() const
+        {
+            if (!m_tree) {
+                throw std::logic_error("Dereferencing end iterator");
+            }
+            return m_tree->m_data[m_positions ? (*m_positions)[m_index] : m_index];
+        }
+
+        const T* operator->() const
+        {
+            return &(this->operator*());
+        }
+    };
+
+    /**
+     * @brief Constructeur de la classe TLinearQuadTree.
+     *
+     * @param limits Les limites géométriques du QuadTree.
+     */
+    TLinearQuadTree(const SLimits& limits = { 0.0f,0.0f,1.0f,1.0f })
+        : _limits(limits)
+    {
+    }
+
+    /**
+     * @brief Constructeur de copie : une lecture de other, qui applique donc ses modifications en attente.
+     */
+    TLinearQuadTree(const TLinearQuadTree& other)
+    {
+        *this = other;
+    }
+
+    TLinearQuadTree(TLinearQuadTree&& other) noexcept = default;
+
+    /**
+     * @brief Opérateur d'affectation par copie (applique les modifications en attente de other).
+     */
+    TLinearQuadTree& operator=(const TLinearQuadTree& other)
+    {
+        if (this != &other) {
+            other.applyPending();
+            _limits = other._limits;
+            m_keys = other.m_keys;
+            m_data = other.m_data;
+            m_bounds = other.m_bounds;
+            m_pendingKeys.clear();
+            m_pending.clear();
+            m_removed.clear();
+            m_removedCount = 0;
+            m_size = other.m_size;
+            m_commit.dirty.store(false, std::memory_order_relaxed);
+        }
+        return *this;
+    }
+
+    TLinearQuadTree& operator=(TLinearQuadTree&& other) noexcept = default;
+
+    /**
+     * @brief Retourne les limites géométriques de ce QuadTree
+     */
+    SLimits limits() const
+    {
+        return _limits;
+    }
+
+    /**
+     * @brief Vérifie si le QuadTree est vide.
+     */
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    /**
+     * @brief Retourne le nombre d'éléments stockés dans le QuadTree.
+     */
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    /**
+     * @brief Retourne la profondeur maximale du QuadTree.
+     *
+     * Il n'y a pas de nœuds vides dans un QuadTree linéaire : la profondeur est le nombre de niveaux
+     * jusqu'au plus profond quadrant portant un élément (1 si l'arbre est vide).
+     */
+    size_t depth() const
+    {
+        applyPending();
+        unsigned level = 0;
+        for (std::uint64_t key : m_keys) {
+            level = std::max(level, static_cast<unsigned>(key & ((1u << LEVEL_BITS) - 1)));
+        }
+        return level + 1;
+    }
+
+    /**
+     * @brief Insère un élément dans le QuadTree.
+     *
+     * L'élément est mis en attente ; il sera trié avec les autres à la prochaine lecture.
+     *
+     * @param t L'élément à insérer.
+     * @throws std::domain_error Si l'élément est en dehors des limites du QuadTree.
+     */
+    void insert(const T& t)
+    {
+        SLimits r = boundsOf(t);
+        if (!isFullyInside(r, _limits)) {
+            throw std::domain_error("Object out of quadtree bounds");
+        }
+        m_pendingKeys.push_back(keyOf(r));
+        m_pending.push_back(t);
+        ++m_size;
+        m_commit.dirty.store(true, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Retire un élément du QuadTree (une seule occurrence).
+     *
+     * Dans les tableaux triés, la recherche se limite aux éléments de même clé, et l'élément trouvé est seulement
+     * marqué : il disparaît à la prochaine lecture, qui compacte tous les retraits en une passe. Sinon, l'élément
+     * est cherché parmi les insertions en attente (les plus récentes d'abord) et retiré de celles-ci.
+     */
+    void remove(const T& t)
+    {
+        SLimits r = boundsOf(t);
+        const std::uint64_t key = keyOf(r);
+        auto range = std::equal_range(m_keys.begin(), m_keys.end(), key);
+        for (auto it = range.first; it != range.second; ++it) {
+            const std::size_t i = static_cast<std::size_t>(it - m_keys.begin());
+            if ((m_removed.empty() || !m_removed[i]) && m_data[i] == t) {
+                if (m_removed.empty()) {
+                    m_removed.resize(m_data.size());
+                }
+                m_removed[i] = 1;
+                ++m_removedCount;
+                --m_size;
+                m_commit.dirty.store(true, std::memory_order_relaxed);
+                return;
+            }
+        }
+        for (std::size_t i = m_pending.size(); i-- > 0;) {
+            if (m_pendingKeys[i] == key && m_pending[i] == t) {
+                // L'ordre des insertions en attente est conservé : à clé égale, il donne l'ordre final
+                m_pendingKeys.erase(m_pendingKeys.begin() + i);
+                m_pending.erase(m_pending.begin() + i);
+                --m_size;
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Vide le QuadTree.
+     */
+    void clear()
+    {
+        m_keys.clear();
+        m_data.clear();
+        m_bounds.clear();
+        m_pendingKeys.clear();
+        m_pending.clear();
+        m_removed.clear();
+        m_removedCount = 0;
+        m_size = 0;
+        m_commit.dirty.store(false, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Récupère tous les éléments stockés dans le QuadTree, dans l'ordre des clés.
+     */
+    container getAll() const
+    {
+        applyPending();
+        return m_data;
+    }
+
+    /**
+     * @brief Trouve les éléments totalement inclus dans une zone spécifiée.
+     *
+     */
+    container findInscribed(const SLimits& limits) const
+    {
+        applyPending();
+        container result;
+        auto collect = [this, &result](std::size_t i) { result.push_back(m_data[i]); };
+        query(0, 0, _limits, 0, m_data.size(), limits, true, collect);
+        return result;
+    }
+
+    /**
+     * @brief Trouve les éléments en collision avec une zone spécifiée.
+     *
+     */
+    container findColliding(const SLimits& limits) const
+    {
+        applyPending();
+        container result;
+        auto collect = [this, &result](std::size_t i) { result.push_back(m_data[i]); };
+        query(0, 0, _limits, 0, m_data.size(), limits, false, collect);
+        return result;
+    }
+
+    /**
+     * @brief Itérateur sur tous les éléments.
+     */
+    iterator begin() const
+    {
+        applyPending();
+        return iterator(this, nullptr);
+    }
+
+    /**
+     * @brief Itérateur sur les éléments qui collisionnent 'limits'.
+     */
+    iterator beginColliding(const SLimits& limits) const
+    {
+        return iterator(this, std::make_shared<const std::vector<std::uint32_t>>(positions(limits, false)));
+    }
+
+    /**
+     * @brief Itérateur sur les éléments entièrement inclus dans 'limits'.
+     */
+    iterator beginInscribed(const SLimits& limits) const
+    {
+        return iterator(this, std::make_shared<const std::vector<std::uint32_t>>(positions(limits, true)));
+    }
+
+    /**
+     * @brief Itérateur de fin (sentinelle).
+     */
+    iterator end() const
+    {
+        return {};
+    }
+};
@@ -1,7 +1,20 @@
 #pragma once
 //Evidemment, il va falloir inclure les fichiers nécessaires pour que le code compile
 #include <vector>
+#include <cstdint>
+#include <atomic>
+#include <bit>
+#include <limits>
+#include <queue>
+#include <iterator>
 #include <memory>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include "QuadTreeConfig.h"
+#include "QuadTreeSimd.h"
+#include "QuadTreeSlab.h"
 //Vous n'avez pas le droit de modifier cette partie du code jusqu'à la ligne notée par le commentaire //Vous pouvez modifier le code ci-dessous
 #include <concepts>
 #include <stdexcept>
@@ -61,8 +74,19 @@ class TQuadTree
 public:
     using container = std::vector<T>;
 
+    /**
+     * @brief Résultats par pointeurs vers les éléments stockés, sans copie des T.
+     *
+     * Les pointeurs restent valides jusqu'à la prochaine modification du QuadTree.
+     */
+    using pointer_container = std::vector<const T*>;
+
     /**
       * @brief Itérateur pour parcourir les éléments du QuadTree.
+      *
+      * Le parcours est paresseux : l'itérateur garde une pile des nœuds à visiter (de taille proportionnelle
+      * à la profondeur) et sa position dans le nœud courant, et ne filtre les éléments qu'au fur et à mesure.
+      * Toute modification du QuadTree invalide ses itérateurs.
       */
     class iterator {
     public:
@@ -75,10 +99,116 @@ public:
         using iterator_category = std::input_iterator_tag;
 
     private:
-        typename container::const_iterator _current;
-        typename container::const_iterator _end;
-        std::shared_ptr<container> m_data;
-        std::size_t m_index = 0;
+        friend class TQuadTree;
+
+        /**
+         * @brief Éléments retenus par l'itérateur.
+         */
+        enum class EFilter
+        {
+            all,        ///< Tous les éléments
+            colliding,  ///< Éléments en collision avec m_limits
+            inscribed   ///< Éléments entièrement inclus dans m_limits
+        };
+
+        const TQuadTree* m_tree = nullptr;      ///< Arbre parcouru ; nullptr pour l'itérateur de fin
+        EFilter m_filter = EFilter::all;
+        SLimits m_limits{};
+        std::vector<std::uint32_t> m_stack;     ///< Nœuds restant à visiter (au plus 3 par niveau)
+        std::uint32_t m_node = 0;               ///< Nœud courant
+        bool m_covered = false;                 ///< Le nœud courant (et donc son sous-arbre) est entièrement dans m_limits
+        std::size_t m_batch = 0;                ///< Début du paquet d'éléments courant dans le nœud
+        std::uint64_t m_mask = 0;               ///< Éléments retenus restants du paquet, l'élément courant compris
+        std::size_t m_index = 0;                ///< Position de l'élément courant dans le nœud
+
+        /**
+         * @brief Itérateur positionné sur le premier élément de 'tree' retenu par le filtre.
+         */
+        iterator(const TQuadTree* tree, EFilter filter, const SLimits& limits)
+            : m_tree(tree), m_filter(filter), m_limits(limits)
+        {
+            if (tree->m_nodes.empty() || !accepts(ROOT)) {
+                m_tree = nullptr;
+                return;
+            }
+            enter(ROOT);
+            settle();
+        }
+
+        /**
+         * @brief Indique si le sous-arbre du nœud 'index' peut contenir des éléments retenus.
+         */
+        bool accepts(std::uint32_t index) const noexcept
+        {
+            return m_filter == EFilter::all || overlap(m_tree->m_nodes[index].loose, m_limits);
+        }
+
+        /**
+         * @brief Masque des éléments retenus du paquet commençant à 'first' dans le nœud 'index'.
+         */
+        std::uint64_t batchMask(std::uint32_t index, std::size_t first) const
+        {
+            const auto& node = m_tree->m_nodes[index];
+            const std::size_t count = std::min(CBoxFilter::BATCH, node.ids.size() - first);
+            const SLimits& l = m_limits;
+            switch (m_covered ? EFilter::all : m_filter) {
+            case EFilter::colliding:
+                return CBoxFilter::overlapMask(node.bounds, first, count, l.x1, l.y1, l.x2, l.y2);
+            case EFilter::inscribed:
+                return CBoxFilter::insideMask(node.bounds, first, count, l.x1, l.y1, l.x2, l.y2);
+            default:
+                return count == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << count) - 1;
+            }
+        }
+
+        /**
+         * @brief Commence la visite du nœud 'index' : empile ses enfants retenus et filtre son premier paquet.
+         *
+         * Les enfants sont empilés en ordre inverse pour être visités dans l'ordre NO, NE, SO, SE,
+         * comme dans getAll() et les recherches. Dans un nœud entièrement inclus dans la zone,
+         * tous les éléments et tous les enfants sont retenus sans test.
+         */
+        void enter(std::uint32_t index)
+        {
+            const auto& node = m_tree->m_nodes[index];
+            m_covered = m_filter == EFilter::all || isFullyInside(node.loose, m_limits);
+            if (node.hasChildren()) {
+                for (std::uint32_t i = 4; i-- > 0;) {
+                    if (m_covered || accepts(node.firstChild + i)) {
+                        m_stack.push_back(node.firstChild + i);
+                    }
+                }
+            }
+            m_node = index;
+            m_batch = 0;
+            m_mask = node.ids.empty() ? 0 : batchMask(index, 0);
+        }
+
+        /**
+         * @brief Avance jusqu'au prochain élément retenu (l'élément courant s'il l'est), ou devient l'itérateur de fin.
+         */
+        void settle()
+        {
+            for (;;) {
+                if (m_mask) {
+                    m_index = m_batch + static_cast<std::size_t>(std::countr_zero(m_mask));
+                    return;
+                }
+                m_batch += CBoxFilter::BATCH;
+                if (m_batch < m_tree->m_nodes[m_node].ids.size()) {
+                    m_mask = batchMask(m_node, m_batch);
+                }
+                else if (m_stack.empty()) {
+                    *this = iterator();
+                    return;
+                }
+                else {
+                    const std::uint32_t next = m_stack.back();
+                    m_stack.pop_back();
+                    enter(next);
+                }
+            }
+        }
 
     public:
         /**
@@ -87,12 +217,10 @@ public:
          * Evidemment, il va falloir compléter cette fonction pour qu'elle initialise correctement l'itérateur.
          * Peut-être que l'itérateur devrait être initialisé à la fin de la liste de données.
          * Peut-etre qu'on peut ajouter d'autres constructeurs pour initialiser l'itérateur à un endroit spécifique.
+         *
+         * Un itérateur construit par défaut est l'itérateur de fin.
          */
         iterator() = default;
-        iterator(std::shared_ptr<container> data, std::size_t idx)
-            : m_data(std::move(data)), m_index(idx)
-        {
-        }
 
         /**
          * @brief Opérateur de comparaison d'égalité.
@@ -103,17 +231,11 @@ public:
         {
             //Evidemment, il va falloir compléter cette fonction pour qu'elle retourne true si les deux itérateurs sont à la même position
 
-            // Cas "end" => deux m_data nuls
-            if (!m_data && !other.m_data) {
-                return true;
-            }
-
-            if (!m_data || !other.m_data) {
+            // Deux itérateurs de fin sont égaux ; sinon, compare arbre + nœud + position dans le nœud
+            if (m_tree != other.m_tree) {
                 return false;
             }
-
-            // Sinon, compare vecteur + index
-            return (m_data == other.m_data) && (m_index == other.m_index);
+            return !m_tree || (m_node == other.m_node && m_index == other.m_index);
         }
 
         bool operator!=(const iterator& other) const
@@ -129,16 +251,12 @@ public:
         iterator& operator++()
         {
             //Evidemment, il va falloir compléter cette fonction pour qu'elle avance l'itérateur à la prochaine position valide
-            if (!m_data) {
-                // Already end
+            if (!m_tree) {
+                // Déjà à la fin
                 return *this;
             }
-            ++m_index;
-            if (m_index >= m_data->size()) {
-                // Devenir "end"
-                m_data.reset();
-                m_index = 0;
-            }
+            m_mask &= m_mask - 1;
+            settle();
             return *this;
         }
 
@@ -164,10 +282,10 @@ public:
          */
         const T& operator*() const
         {
-            if (!m_data) {
+            if (!m_tree) {
                 throw std::logic_error("Dereferencing end iterator");
             }
-            return (*m_data)[m_index];
+            return m_tree->m_items[m_tree->m_nodes[m_node].ids[m_index]];
         }
 
         T* operator->()
@@ -176,11 +294,154 @@ public:
         }
     };
 
+    /**
+     * @brief Enregistrement agrégé d'un nœud trop petit pour être détaillé (voir forEachCollidingLod).
+     */
+    struct SAggregate
+    {
+        SLimits limits;             ///< Zone du nœud (limites élargies), qui contient tous les éléments agrégés
+        std::size_t count;          ///< Nombre d'éléments du nœud et de ses descendants
+        const T* representative;    ///< Un des éléments agrégés (valide jusqu'à la prochaine modification du QuadTree)
+    };
+
 private:
-    static constexpr std::size_t CAPACITY = 1;  ///< Nombre max. d'éléments avant subdivision
-    SLimits _limits;
-    container m_data;
-    std::unique_ptr<TQuadTree> m_children[4] = { nullptr };
+    /**
+     * @brief Les QuadTree de types différents accèdent à leurs nœuds respectifs lors d'une jointure (voir spatialJoin).
+     */
+    template<QuadTreeData>
+    friend class TQuadTree;
+
+    /**
+     * @brief Indice de la racine dans l'arène.
+     */
+    static constexpr std::uint32_t ROOT = 0;
+
+    /**
+     * @brief Valeur de firstChild pour un nœud sans enfants.
+     *
+     * La racine occupe toujours l'indice 0 de l'arène et n'est l'enfant de personne :
+     * 0 ne peut donc jamais désigner un groupe d'enfants.
+     */
+    static constexpr std::uint32_t NO_CHILDREN = 0;
+
+    /**
+     * @brief Nœud du QuadTree, stocké dans l'arène contiguë m_nodes.
+     *
+     * Les 4 enfants d'un nœud sont alloués ensemble et occupent 4 cases consécutives
+     * de l'arène à partir de firstChild, dans l'ordre NO, NE, SO, SE.
+     *
+     * Les éléments eux-mêmes sont dans la réserve m_items : un nœud n'en garde que les indices (ids),
+     * avec leurs limites dupliquées dans bounds (même position que dans ids). Les filtres parcourent ces flottants
+     * compacts et ne lisent m_items que pour les éléments retenus.
+     *
+     * Les éléments du sous-arbre sont tous contenus dans loose, qui sert donc à l'élagage des recherches.
+     */
+    struct SNode
+    {
+        SLimits limits;                           ///< Limites géométriques du nœud
+        SLimits loose;                            ///< Limites élargies par SQuadTreeConfig::looseness (égales à limits par défaut)
+        std::vector<std::uint32_t> ids;           ///< Indices dans m_items des éléments stockés dans ce nœud
+        CBoundsArray bounds;                      ///< Limites des éléments de ids, en structure de tableaux
+        std::uint32_t firstChild = NO_CHILDREN;   ///< Indice du premier des 4 enfants
+        std::uint32_t count = 0;                  ///< Nombre d'éléments du sous-arbre (ce nœud et sa descendance)
+
+        explicit SNode(const SLimits& l) : limits(l), loose(l) {}
+        SNode(const SLimits& l, const SLimits& lo) : limits(l), loose(lo) {}
+
+        bool hasChildren() const noexcept { return firstChild != NO_CHILDREN; }
+
+        /**
+         * @brief Limites de l'élément i.
+         */
+        SLimits boundsAt(std::size_t i) const noexcept
+        {
+            return { bounds.x1()[i], bounds.y1()[i], bounds.x2()[i], bounds.y2()[i] };
+        }
+
+        /**
+         * @brief Ajoute l'élément d'indice id, de limites r.
+         */
+        void push(std::uint32_t id, const SLimits& r)
+        {
+            ids.push_back(id);
+            bounds.push_back(r.x1, r.y1, r.x2, r.y2);
+        }
+
+        /**
+         * @brief Retire l'élément i en le remplaçant par le dernier.
+         */
+        void eraseAt(std::size_t i)
+        {
+            ids[i] = ids.back();
+            ids.pop_back();
+            bounds.eraseSwap(i);
+        }
+
+        /**
+         * @brief Retire tous les éléments du nœud.
+         */
+        void clearItems() noexcept
+        {
+            ids.clear();
+            bounds.clear();
+        }
+    };
+
+    /**
+     * @brief Arène des nœuds : la racine est en m_nodes[ROOT], les enfants sont adressés par indices 32 bits.
+     *
+     * Vide après un déplacement (le QuadTree déplacé n'alloue rien) : la racine est alors recréée par la première
+     * modification (voir ensureRoot) et les recherches traitent l'arène vide comme un arbre vide.
+     */
+    std::vector<SNode> m_nodes;
+
+    /**
+     * @brief Limites géométriques du QuadTree (celles de la racine), gardées même quand l'arène est vide.
+     */
+    SLimits m_limits;
+
+    /**
+     * @brief Paramètres de subdivision (capacité des feuilles, profondeur max., critère).
+     */
+    SQuadTreeConfig m_config;
+
+    /**
+     * @brief Réserve des éléments : chaque T n'est stocké qu'une fois, les nœuds n'en manipulent que l'indice.
+     *
+     * Les cases libérées par remove() sont listées dans m_freeItems et réutilisées par les insertions suivantes.
+     * La réserve est découpée en blocs (voir TItemSlab) : elle grandit sans recopier les éléments déjà rangés.
+     */
+    TItemSlab<T> m_items;
+    std::vector<std::uint32_t> m_freeItems;
+
+    /**
+     * @brief Groupes de 4 enfants libérés par remove() (indice du premier), réutilisés par les subdivisions suivantes.
+     */
+    std::vector<std::uint32_t> m_freeGroups;
+
+    /**
+     * @brief Génération du contenu, tirée de nextGeneration() à la construction et à chaque modification (voir generation()).
+     */
+    std::uint64_t m_generation = nextGeneration();
+
+    /**
+     * @brief Retourne une génération jamais utilisée par aucun QuadTree de ce type dans le processus (jamais 0).
+     *
+     * Chaque thread réserve les valeurs par blocs dans un compteur commun : une insertion ne paie pas
+     * une opération atomique.
+     */
+    static std::uint64_t nextGeneration() noexcept
+    {
+        constexpr std::uint64_t BLOCK = 1024;
+        static std::atomic<std::uint64_t> counter{ 1 };
+        thread_local std::uint64_t next = 0;
+        thread_local std::uint64_t end = 0;
+        if (next == end) {
+            next = counter.fetch_add(BLOCK, std::memory_order_relaxed);
+            end = next + BLOCK;
+        }
+        return next++;
+    }
 
     /**
      * @brief Epsilon pour accepter un léger dépassement/arrondi dans isFullyInside.
@@ -216,301 +477,1650 @@ private:
     /**
      * @brief Indique si le rectangle r peut s'insérer entièrement dans un des 4 enfants (si on subdivise).
      */
-    bool canFitChild(const SLimits& r) const noexcept
+    bool canFitChild(const SLimits& limits, const SLimits& r) const noexcept
     {
         // Calcul midX, midY en double pour limiter les écarts
-        float midX = (_limits.x1 + _limits.x2) * 0.5f;
-        float midY = (_limits.y1 + _limits.y2) * 0.5f;
+        float midX = (limits.x1 + limits.x2) * 0.5f;
+        float midY = (limits.y1 + limits.y2) * 0.5f;
 
         // Quadrants
         SLimits child[4] = {
-          { _limits.x1, _limits.y1, midX,       midY       }, // NW
-          { midX,        _limits.y1, _limits.x2, midY       }, // NE
-          { _limits.x1, midY,        midX,        _limits.y2}, // SW
-          { midX,        midY,        _limits.x2, _limits.y2}, // SE
+          { limits.x1, limits.y1, midX,      midY      }, // NW
+          { midX,      limits.y1, limits.x2, midY      }, // NE
+          { limits.x1, midY,      midX,      limits.y2 }, // SW
+          { midX,      midY,      limits.x2, limits.y2 }, // SE
         };
         for (int i = 0; i < 4; i++) {
-            if (isFullyInside(r, child[i])) {
+            if (isFullyInside(r, loosen(child[i]))) {
                 return true;
             }
         }
         return false;
     }
 
-
     /**
-     * @brief Subdivise le nœud courant en 4, et réaffecte si possible les éléments dans les enfants.
+     * @brief Limites l élargies autour de leur centre par le facteur de relâchement de la configuration.
      */
-    void subdivide()
+    SLimits loosen(const SLimits& l) const noexcept
     {
-        // Déjà subdivisé ?
-        if (m_children[0]) {
-            return;
-        }
-
-        // Calcul en double
-        float midX = (_limits.x1 + _limits.x2) * 0.5f;
-        float midY = (_limits.y1 + _limits.y2) * 0.5f;
-
-        // Crée les 4 enfants
-        m_children[0] = std::make_unique<TQuadTree>(SLimits{ _limits.x1, _limits.y1, midX,       midY }); // NW
-        m_children[1] = std::make_unique<TQuadTree>(SLimits{ midX,        _limits.y1, _limits.x2, midY }); // NE
-        m_children[2] = std::make_unique<TQuadTree>(SLimits{ _limits.x1, midY,        midX,        _limits.y2 }); // SW
-        m_children[3] = std::make_unique<TQuadTree>(SLimits{ midX,        midY,        _limits.x2, _limits.y2 }); // SE
-
-        // Tente de redescendre les éléments existants
-        container remain;
-        remain.reserve(m_data.size());
-
-        for (const auto& item : m_data) {
-            SLimits r = boundsOf(item);
-            bool placed = false;
-            for (int i = 0; i < 4; ++i) {
-                if (isFullyInside(r, m_children[i]->_limits)) {
-                    m_children[i]->insert(item);
-                    placed = true;
-                    break;
-                }
-            }
-            if (!placed) {
-                remain.push_back(item);
-            }
+        if (m_config.looseness == 1.0f) {
+            return l;
         }
-
-        // on swap
-        m_data.swap(remain);
+        const float halfW = (l.x2 - l.x1) * 0.5f * m_config.looseness;
+        const float halfH = (l.y2 - l.y1) * 0.5f * m_config.looseness;
+        const float midX = (l.x1 + l.x2) * 0.5f;
+        const float midY = (l.y1 + l.y2) * 0.5f;
+        return { midX - halfW, midY - halfH, midX + halfW, midY + halfH };
     }
 
     /**
-     * @brief Copie récursive d'un autre TQuadTree.
+     * @brief Indique si la feuille 'index', de profondeur 'depth', doit être subdivisée après l'insertion de r.
      */
-    void copyFrom(const TQuadTree& other)
+    bool shouldSplit(std::uint32_t index, std::size_t depth, const SLimits& r) const noexcept
     {
-        _limits = other._limits;
-        m_data = other.m_data;
-        for (int i = 0; i < 4; i++) {
-            if (other.m_children[i]) {
-                m_children[i] = std::make_unique<TQuadTree>(*other.m_children[i]);
-            }
-            else {
-                m_children[i].reset();
-            }
+        const SNode& node = m_nodes[index];
+        if (depth >= m_config.maxDepth) {
+            return false;
         }
+        return node.ids.size() > m_config.capacity || itemTriggersSplit(node.limits, r);
     }
 
-public:
     /**
-     * @brief Constructeur de la classe TQuadTree.
+     * @brief Indique si l'élément r, arrivant dans une feuille de limites l, provoque à lui seul la subdivision.
      *
-     * @param limits Les limites géométriques du QuadTree.
-     */
-    TQuadTree(const SLimits& limits = { 0.0f,0.0f,1.0f,1.0f })
-        : _limits(limits)
-    {
-        //Evidemment, il va falloir compléter ce constructeur pour qu'il initialise correctement votre TQuadTree
-    }
-
-    /**
-     * @brief Constructeur de copie.
+     * Avec le dépassement de capacité, c'est le seul critère de subdivision : le résultat ne dépend donc que
+     * de l'ensemble des éléments arrivés dans la feuille, pas de leur ordre (voir buildNode).
      */
-    TQuadTree(const TQuadTree& other)
+    bool itemTriggersSplit(const SLimits& l, const SLimits& r) const noexcept
     {
-        copyFrom(other);
+        switch (m_config.trigger) {
+        case ESplitTrigger::eagerFit:
+            return canFitChild(l, r);
+        case ESplitTrigger::areaRatio:
+        {
+            const float itemArea = (r.x2 - r.x1) * (r.y2 - r.y1);
+            const float nodeArea = (l.x2 - l.x1) * (l.y2 - l.y1);
+            return itemArea <= m_config.areaRatio * nodeArea && canFitChild(l, r);
+        }
+        default:
+            return false;
+        }
     }
 
     /**
-     * @brief Opérateur d'affectation par copie.
+     * @brief Retourne l'indice du premier enfant du nœud 'index' dont les limites élargies contiennent entièrement r,
+     *        ou NO_CHILDREN si aucun ne convient (ou si le nœud n'a pas d'enfants).
      */
-    TQuadTree& operator=(const TQuadTree& other)
+    std::uint32_t childContaining(std::uint32_t index, const SLimits& r) const noexcept
     {
-        if (this != &other) {
-            clear();
-            copyFrom(other);
+        const SNode& node = m_nodes[index];
+        const std::uint32_t first = node.firstChild;
+        if (first == NO_CHILDREN) {
+            return NO_CHILDREN;
         }
-        return *this;
+        if (m_config.looseness == 1.0f) {
+            // Les enfants partagent les médianes du nœud (calculées comme dans allocateChildren) : le quadrant se
+            // déduit de r sans lire les 4 enfants. À égalité, même préférence que ci-dessous : haut puis gauche.
+            const SLimits& l = node.limits;
+            const float midX = (l.x1 + l.x2) * 0.5f;
+            const float midY = (l.y1 + l.y2) * 0.5f;
+            const bool left = r.x1 >= l.x1 && r.x2 <= midX;
+            const bool right = r.x1 >= midX && r.x2 <= l.x2;
+            const bool top = r.y1 >= l.y1 && r.y2 <= midY;
+            const bool bottom = r.y1 >= midY && r.y2 <= l.y2;
+            if (!(left || right) || !(top || bottom)) {
+                return NO_CHILDREN;
+            }
+            return first + (top ? 0 : 2) + (left ? 0 : 1);
+        }
+        for (std::uint32_t i = 0; i < 4; ++i) {
+            if (isFullyInside(r, m_nodes[first + i].loose)) {
+                return first + i;
+            }
+        }
+        return NO_CHILDREN;
     }
 
     /**
-     * @brief Retourne les limites géométriques de ce QuadTree
+     * @brief Recrée la racine si l'arène est vide (QuadTree déplacé).
      */
-    SLimits limits() const
+    void ensureRoot()
     {
-        //Evidemment, il va falloir compléter cette fonction pour qu'elle retourne les limites géométriques de ce QuadTree
-        return _limits;
+        if (m_nodes.empty()) {
+            m_nodes.emplace_back(m_limits, loosen(m_limits));
+        }
     }
 
     /**
-     * @brief Vérifie si le QuadTree est vide.
+     * @brief Range t dans la réserve, dans une case libérée s'il y en a.
      *
-     * Cette fonction vérifie si le QuadTree ne contient aucun élément de données, y compris dans la descendance.
-     *
-     * @return true si le QuadTree est vide, false sinon.
+     * @return L'indice de t dans m_items.
      */
-    bool empty() const
+    template<typename U>
+    std::uint32_t allocateItem(U&& t)
     {
-        //Evidemment, il va falloir compléter cette fonction pour qu'elle retourne true uniquement si le QuadTree est vide
-        return (size() == 0);
+        if (!m_freeItems.empty()) {
+            const std::uint32_t id = m_freeItems.back();
+            m_items[id] = std::forward<U>(t);
+            m_freeItems.pop_back();
+            return id;
+        }
+        if (m_items.size() == std::numeric_limits<std::uint32_t>::max()) {
+            throw std::length_error("Too many objects for a QuadTree");
+        }
+        m_items.push_back(std::forward<U>(t));
+        return static_cast<std::uint32_t>(m_items.size() - 1);
     }
 
     /**
-     * @brief Retourne la profondeur maximale du QuadTree.
+     * @brief Libère la case id pour une insertion suivante.
      *
-     * La profondeur maximale du QuadTree correspond nombre maximal de niveaux de descendants.
+     * Si T a un constructeur par défaut qui ne lève pas d'exception, l'élément est remplacé par T{} : les ressources
+     * qu'il détenait sont libérées tout de suite. Sinon, il reste en vie jusqu'à la réutilisation de sa case,
+     * ou jusqu'à clear() ou compact().
      */
-    size_t depth() const
+    void releaseItem(std::uint32_t id)
     {
-        //Evidemment, il va falloir compléter cette fonction pour qu'elle retourne la profondeur maximale du QuadTree
-        if (!m_children[0]) {
-            return 1;
-        }
-        // 1 + max(enfants)
-        std::size_t maxD = 0;
-        for (int i = 0; i < 4; i++) {
-            if (m_children[i]) {
-                std::size_t d = m_children[i]->depth();
-                if (d > maxD) {
-                    maxD = d;
-                }
-            }
+        m_freeItems.push_back(id);
+        if constexpr (std::is_nothrow_default_constructible_v<T> && std::is_nothrow_move_assignable_v<T>) {
+            m_items[id] = T{};
         }
-        return 1 + maxD;
     }
 
     /**
-     * @brief Retourne le nombre d'éléments stockés dans le QuadTree.
+     * @brief Construit un élément à partir de args directement dans la réserve.
      *
-     * Cette fonction retourne le nombre d'éléments stockés dans le QuadTree en incluant toute la descendance.
+     * Une case libérée n'est réutilisée que si la construction ne peut pas échouer (son ancien occupant est détruit
+     * avant) ; sinon l'élément est construit à la fin de la réserve.
      *
-     * @return Le nombre d'éléments stockés dans le QuadTree.
+     * @return L'indice de l'élément dans m_items.
      */
-    size_t size() const
+    template<typename... Args>
+    std::uint32_t emplaceItem(Args&&... args)
     {
-        //Evidemment, il va falloir compléter cette fonction pour qu'elle retourne le nombre d'éléments stockés dans le QuadTree
-        std::size_t s = m_data.size();
-        for (int i = 0; i < 4; i++) {
-            if (m_children[i]) {
-                s += m_children[i]->size();
+        if constexpr (std::is_nothrow_constructible_v<T, Args...>) {
+            if (!m_freeItems.empty()) {
+                const std::uint32_t id = m_freeItems.back();
+                T& slot = m_items[id];
+                std::destroy_at(&slot);
+                std::construct_at(&slot, std::forward<Args>(args)...);
+                m_freeItems.pop_back();
+                return id;
             }
         }
-        return s;
+        if (m_items.size() == std::numeric_limits<std::uint32_t>::max()) {
+            throw std::length_error("Too many objects for a QuadTree");
+        }
+        m_items.emplace_back(std::forward<Args>(args)...);
+        return static_cast<std::uint32_t>(m_items.size() - 1);
     }
 
     /**
-  * @brief Insère un élément dans le QuadTree.
-  *
-  * Cette fonction insère l'élément donné dans le QuadTree. Si le nœud courant a des enfants,
-  * elle essaie d'insérer l'élément dans un enfant approprié. Sinon, elle stocke l'élément dans le nœud courant.
-  *
-  * Si le nombre d'éléments dépasse la capacité ou si un élément peut être entièrement contenu dans un enfant,
-  * le nœud est subdivisé.
-  *
-  * @param t L'élément à insérer.
-  * @throws std::domain_error Si l'élément est en dehors des limites du QuadTree.
-  */
-    void insert(const T& t)
+     * @brief Insère l'élément id (de limites r) dans le sous-arbre du nœud 'index', de profondeur 'depth'.
+     *
+     * Descend tant qu'un enfant peut contenir l'élément, puis le stocke et subdivise si nécessaire.
+     * Le compteur de chaque nœud traversé, 'index' compris, est incrémenté.
+     */
+    void insertInto(std::uint32_t index, std::size_t depth, std::uint32_t id, const SLimits& r)
     {
-        SLimits r = boundsOf(t);
-
-        // Vérifie si l'élément est dans les limites du QuadTree
-        if (!isFullyInside(r, _limits)) {
-            throw std::domain_error("Object out of quadtree bounds");
-        }
+        ++m_nodes[index].count;
 
         // Si le nœud a déjà des enfants, tente d'insérer dans un enfant
-        if (m_children[0]) {
-            for (int i = 0; i < 4; i++) {
-                if (isFullyInside(r, m_children[i]->_limits)) {
-                    m_children[i]->insert(t);
-                    return;
-                }
+        while (m_nodes[index].hasChildren()) {
+            std::uint32_t child = childContaining(index, r);
+            if (child == NO_CHILDREN) {
+                // Si aucun enfant ne convient, stocke dans ce nœud
+                m_nodes[index].push(id, r);
+                return;
             }
-            // Si aucun enfant ne convient, stocke dans ce nœud
-            m_data.push_back(t);
-            return;
+            index = child;
+            ++depth;
+            ++m_nodes[index].count;
         }
 
         // Pas d'enfants, ajoute l'élément dans ce nœud
-        m_data.push_back(t);
+        m_nodes[index].push(id, r);
 
-        // Subdivise si nécessaire (capacité dépassée ou l'élément peut rentrer dans un enfant)
-        if (m_data.size() > CAPACITY || canFitChild(r)) {
-            subdivide();
+        // Subdivise si nécessaire, selon la configuration (capacité dépassée, l'élément peut rentrer dans un enfant...)
+        if (shouldSplit(index, depth, r)) {
+            subdivide(index, depth);
         }
     }
 
-
     /**
-     * @brief Vide le QuadTree.
+     * @brief Crée les 4 enfants (vides) du nœud 'index', contigus : dans un groupe libéré s'il y en a,
+     *        sinon à la fin de l'arène.
      *
-     * Cette fonction vide le QuadTree de toutes ses données.
+     * @return L'indice du premier enfant.
      */
-    void clear()
+    std::uint32_t allocateChildren(std::uint32_t index)
     {
-        //Evidemment, il va falloir compléter cette fonction pour qu'elle vide le QuadTree
-        m_data.clear();
-        for (auto& child : m_children) {
-            child.reset();
-        }
-    }
+        const SLimits l = m_nodes[index].limits;
+        float midX = (l.x1 + l.x2) * 0.5f;
+        float midY = (l.y1 + l.y2) * 0.5f;
+        const SLimits children[4] = {
+          { l.x1, l.y1, midX, midY }, // NW
+          { midX, l.y1, l.x2, midY }, // NE
+          { l.x1, midY, midX, l.y2 }, // SW
+          { midX, midY, l.x2, l.y2 }, // SE
+        };
 
-    void remove(const T& t)
-    {
-        //Evidemment, il va falloir compléter cette fonction pour qu'elle retire l'élément du QuadTree
-        SLimits r = boundsOf(t);
-        // Si on a des enfants, on voit si l'élément peut y être
-        if (m_children[0]) {
-            for (int i = 0; i < 4; i++) {
-                if (isFullyInside(r, m_children[i]->_limits)) {
-                    m_children[i]->remove(t);
-                    return;
-                }
+        if (!m_freeGroups.empty()) {
+            const std::uint32_t first = m_freeGroups.back();
+            m_freeGroups.pop_back();
+            for (std::uint32_t i = 0; i < 4; i++) {
+                SNode& child = m_nodes[first + i];
+                child.limits = children[i];
+                child.loose = loosen(children[i]);
             }
-        }
-        // Sinon, on le retire de ce nœud localement
-        auto it = std::find(m_data.begin(), m_data.end(), t);
-        if (it != m_data.end()) {
-            m_data.erase(it);
+            m_nodes[index].firstChild = first;
+            return first;
         }
 
+        if (m_nodes.size() > std::numeric_limits<std::uint32_t>::max() - 4) {
+            throw std::length_error("QuadTree node arena is full");
+        }
+        const auto first = static_cast<std::uint32_t>(m_nodes.size());
+        for (const SLimits& child : children) {
+            m_nodes.emplace_back(child, loosen(child));
+        }
+        m_nodes[index].firstChild = first;
+        return first;
     }
 
     /**
- * @brief Récupère tous les éléments stockés dans le QuadTree.
- *
- * Cette fonction retourne une liste de tous les éléments stockés dans le QuadTree,
- * y compris ceux stockés dans les enfants.
- *
- * @return Une liste de tous les éléments stockés dans le QuadTree.
- */
-    container getAll() const
+     * @brief Ramène dans le nœud 'target' les éléments du sous-arbre du nœud 'index', puis libère ses descendants.
+     */
+    void absorbInto(std::uint32_t target, std::uint32_t index)
     {
-        container result;
-        result.reserve(size()); // Préalloue l'espace pour optimiser les insertions
-
-        // Ajoute les éléments de l'objet courant
-        result.insert(result.end(), m_data.begin(), m_data.end());
-
-        // Parcourt les enfants et récupère leurs éléments récursivement
-        for (int i = 0; i < 4; i++) {
-            if (m_children[i]) {
-                container childResults = m_children[i]->getAll();
-                result.insert(result.end(), childResults.begin(), childResults.end());
+        SNode& node = m_nodes[index];
+        if (index != target) {
+            for (std::size_t i = 0; i < node.ids.size(); ++i) {
+                m_nodes[target].push(node.ids[i], node.boundsAt(i));
             }
+            node.clearItems();
+            node.count = 0;
+        }
+        if (node.hasChildren()) {
+            const std::uint32_t first = node.firstChild;
+            node.firstChild = NO_CHILDREN;
+            for (std::uint32_t i = 0; i < 4; i++) {
+                absorbInto(target, first + i);
+            }
+            m_freeGroups.push_back(first);
         }
-
-        return result;
     }
 
     /**
-     * @brief Trouve les éléments dans une zone spécifiée.
+     * @brief Regroupe les enfants du nœud 'index' dans ce nœud si leurs descendants réunis comptent au plus
+     *        mergeThreshold éléments (test en temps constant grâce aux compteurs de sous-arbre).
      *
-     * Cette fonction recherche et retourne une liste de tous les éléments stockés dans le QuadTree
-     * qui se trouvent totalement inclus dans la zone spécifiée par limits.
-     *
-     * @param limits Les limites de la zone de recherche.
-     * @return Une liste de tous les éléments trouvés dans la zone spécifiée.
+     * @return true si le nœud a été regroupé.
      */
-     /**
+    bool mergeIfSparse(std::uint32_t index)
+    {
+        const SNode& node = m_nodes[index];
+        if (!node.hasChildren() || node.count - node.ids.size() > m_config.mergeThreshold) {
+            return false;
+        }
+        absorbInto(index, index);
+        return true;
+    }
+
+    /**
+     * @brief Regroupe, du haut vers le bas, tous les nœuds du sous-arbre du nœud 'index' qui peuvent l'être.
+     */
+    void mergeAllIn(std::uint32_t index)
+    {
+        if (!m_nodes[index].hasChildren() || mergeIfSparse(index)) {
+            return;
+        }
+        const std::uint32_t first = m_nodes[index].firstChild;
+        for (std::uint32_t i = 0; i < 4; i++) {
+            mergeAllIn(first + i);
+        }
+    }
+
+    /**
+     * @brief Subdivise le nœud 'index' (de profondeur 'depth') en 4, et réaffecte si possible ses éléments dans les enfants.
+     *
+     * Les 4 enfants sont ajoutés ensemble à la fin de l'arène.
+     * Attention : m_nodes peut être réalloué, les références sur des nœuds deviennent invalides.
+     */
+    void subdivide(std::uint32_t index, std::size_t depth)
+    {
+        // Déjà subdivisé ?
+        if (m_nodes[index].hasChildren()) {
+            return;
+        }
+
+        const SLimits l = m_nodes[index].limits;
+        const std::uint32_t first = allocateChildren(index);
+
+        // On récupère les indices des éléments : les insertions dans les enfants peuvent réallouer l'arène
+        std::vector<std::uint32_t> ids;
+        CBoundsArray itemsBounds;
+        ids.swap(m_nodes[index].ids);
+        itemsBounds.swap(m_nodes[index].bounds);
+
+        // Tente de redescendre les éléments existants : chaque paquet est testé contre les 4 enfants,
+        // un élément allant dans le premier enfant qui le contient (NO, NE, SO, SE)
+        const SLimits children[4] = {
+            m_nodes[first].loose, m_nodes[first + 1].loose, m_nodes[first + 2].loose, m_nodes[first + 3].loose
+        };
+        auto boundsAt = [&itemsBounds](std::size_t i) {
+            return SLimits{ itemsBounds.x1()[i], itemsBounds.y1()[i], itemsBounds.x2()[i], itemsBounds.y2()[i] };
+        };
+        SNode remain(l, m_nodes[index].loose);
+        for (std::size_t batch = 0; batch < ids.size(); batch += CBoxFilter::BATCH) {
+            const std::size_t count = std::min(CBoxFilter::BATCH, ids.size() - batch);
+            std::uint64_t placed = 0;
+            for (std::uint32_t c = 0; c < 4; ++c) {
+                const SLimits& cl = children[c];
+                const std::uint64_t mask = CBoxFilter::insideMask(itemsBounds, batch, count, cl.x1, cl.y1, cl.x2, cl.y2) & ~placed;
+                placed |= mask;
+                CBoxFilter::forEachBit(mask, batch, [&](std::size_t i) { insertInto(first + c, depth + 1, ids[i], boundsAt(i)); });
+            }
+            const std::uint64_t all = count == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << count) - 1;
+            CBoxFilter::forEachBit(all & ~placed, batch, [&](std::size_t i) { remain.push(ids[i], boundsAt(i)); });
+        }
+
+        // on swap
+        m_nodes[index].ids.swap(remain.ids);
+        m_nodes[index].bounds.swap(remain.bounds);
+    }
+
+    /**
+     * @brief Élément en cours de répartition par le chargement en bloc : ses limites et son indice dans m_items.
+     */
+    struct SBuildEntry
+    {
+        SLimits bounds;
+        std::uint32_t id;
+    };
+
+    /**
+     * @brief Construit en une passe le sous-arbre de la feuille 'index' (profondeur 'depth').
+     *
+     * Les éléments de entries[begin..end) sont exactement ceux qu'une suite d'insertions ferait arriver
+     * dans cette feuille. Elle est subdivisée si l'un d'eux le déclencherait ou si leur nombre dépasse la capacité :
+     * l'arbre obtenu est identique à celui des insertions successives, ordre des éléments dans chaque nœud compris.
+     *
+     * Les éléments sont répartis de entries vers scratch, puis les enfants sont construits en inversant les deux
+     * tampons : chaque niveau ne déplace les éléments qu'une fois.
+     *
+     * @param scratch, buckets Tampons de travail, de même taille que entries.
+     */
+    void buildNode(std::uint32_t index, std::size_t depth, std::vector<SBuildEntry>& entries,
+        std::vector<SBuildEntry>& scratch, std::vector<std::uint8_t>& buckets, std::size_t begin, std::size_t end)
+    {
+        const SLimits l = m_nodes[index].limits;
+        const std::size_t n = end - begin;
+        m_nodes[index].count = static_cast<std::uint32_t>(n);
+
+        bool split = false;
+        if (depth < m_config.maxDepth) {
+            split = n > m_config.capacity;
+            for (std::size_t k = begin; k < end && !split; ++k) {
+                split = itemTriggersSplit(l, entries[k].bounds);
+            }
+        }
+        if (!split) {
+            m_nodes[index].ids.reserve(n);
+            m_nodes[index].bounds.reserve(n);
+            for (std::size_t k = begin; k < end; ++k) {
+                m_nodes[index].push(entries[k].id, entries[k].bounds);
+            }
+            return;
+        }
+
+        // Répartition stable des éléments : ceux qui restent dans ce nœud, puis ceux de chaque enfant
+        // (le premier qui les contient, comme dans childContaining)
+        const std::uint32_t first = allocateChildren(index);
+        const SLimits children[4] = {
+            m_nodes[first].loose, m_nodes[first + 1].loose, m_nodes[first + 2].loose, m_nodes[first + 3].loose
+        };
+        std::size_t offsets[6] = { begin };
+        for (std::size_t k = begin; k < end; ++k) {
+            std::uint8_t bucket = 0;
+            for (std::uint8_t c = 0; c < 4 && bucket == 0; ++c) {
+                bucket = isFullyInside(entries[k].bounds, children[c]) ? c + 1 : 0;
+            }
+            buckets[k] = bucket;
+            ++offsets[bucket + 1];
+        }
+        for (std::size_t b = 1; b < 6; ++b) {
+            offsets[b] += offsets[b - 1];
+        }
+        std::size_t cursor[5] = { offsets[0], offsets[1], offsets[2], offsets[3], offsets[4] };
+        for (std::size_t k = begin; k < end; ++k) {
+            scratch[cursor[buckets[k]]++] = entries[k];
+        }
+
+        m_nodes[index].ids.reserve(offsets[1] - offsets[0]);
+        m_nodes[index].bounds.reserve(offsets[1] - offsets[0]);
+        for (std::size_t k = offsets[0]; k < offsets[1]; ++k) {
+            m_nodes[index].push(scratch[k].id, scratch[k].bounds);
+        }
+        for (std::uint32_t c = 0; c < 4; ++c) {
+            buildNode(first + c, depth + 1, scratch, entries, buckets, offsets[c + 1], offsets[c + 2]);
+        }
+    }
+
+    /**
+     * @brief Remplace le contenu de l'arbre par les éléments de [first, last), construits en une passe.
+     *
+     * Tous les éléments sont validés avant de toucher à l'arbre : en cas d'exception, il reste inchangé.
+     */
+    template<std::input_iterator It, std::sentinel_for<It> S>
+    void bulkLoad(It first, S last)
+    {
+        TItemSlab<T> items;
+        std::vector<SBuildEntry> entries;
+        if constexpr (std::sized_sentinel_for<S, It>) {
+            items.reserve(static_cast<std::size_t>(last - first));
+            entries.reserve(static_cast<std::size_t>(last - first));
+        }
+        for (; first != last; ++first) {
+            if (items.size() == std::numeric_limits<std::uint32_t>::max()) {
+                throw std::length_error("Too many objects for a QuadTree");
+            }
+            SLimits r = boundsOf(items.emplace_back(*first));
+            if (!isFullyInside(r, m_limits)) {
+                throw std::domain_error("Object out of quadtree bounds");
+            }
+            entries.push_back({ r, static_cast<std::uint32_t>(items.size() - 1) });
+        }
+
+        clear();
+        m_items.swap(items);
+        std::vector<SBuildEntry> scratch(entries.size());
+        std::vector<std::uint8_t> buckets(entries.size());
+        buildNode(ROOT, 1, entries, scratch, buckets, 0, entries.size());
+    }
+
+    /**
+     * @brief Profondeur du sous-arbre du nœud 'index'.
+     */
+    std::size_t depthOf(std::uint32_t index) const
+    {
+        const SNode& node = m_nodes[index];
+        if (!node.hasChildren()) {
+            return 1;
+        }
+        // 1 + max(enfants)
+        std::size_t maxD = 0;
+        for (std::uint32_t i = 0; i < 4; i++) {
+            maxD = std::max(maxD, depthOf(node.firstChild + i));
+        }
+        return 1 + maxD;
+    }
+
+    /**
+     * @brief Appelle le visiteur f sur args (un élément, éventuellement suivi d'autres arguments).
+     *
+     * @return false si f demande l'arrêt du parcours (un visiteur qui ne retourne rien ne l'arrête jamais).
+     */
+    template<typename F, typename... Args>
+    static bool visit(F& f, const Args&... args)
+    {
+        if constexpr (std::is_void_v<std::invoke_result_t<F&, const Args&...>>) {
+            f(args...);
+            return true;
+        }
+        else {
+            return static_cast<bool>(f(args...));
+        }
+    }
+
+    /**
+     * @brief Appelle f sur tous les éléments du sous-arbre du nœud 'index', sans aucun test.
+     *
+     * @return false si le parcours a été interrompu par f.
+     */
+    template<typename F>
+    bool forEachAllIn(std::uint32_t index, F&& f) const
+    {
+        const SNode& node = m_nodes[index];
+        for (std::uint32_t id : node.ids) {
+            if (!visit(f, m_items[id])) {
+                return false;
+            }
+        }
+        if (node.hasChildren()) {
+            for (std::uint32_t i = 0; i < 4; i++) {
+                if (!forEachAllIn(node.firstChild + i, f)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Ne fait rien : forEachIn sans préallocation.
+     */
+    struct SNoReserve
+    {
+        void operator()(std::size_t) const noexcept {}
+    };
+
+    /**
+     * @brief Préallocation géométrique de out pour n éléments de plus (voir forEachIn).
+     */
+    template<typename C>
+    static auto reserveFor(C& out)
+    {
+        return [&out](std::size_t n) {
+            if (out.capacity() - out.size() < n) {
+                out.reserve(std::max(out.size() + n, 2 * out.capacity()));
+            }
+        };
+    }
+
+    /**
+     * @brief forEachInscribed (Inscribed) ou forEachColliding appliqué au sous-arbre du nœud 'index'.
+     *
+     * Un nœud dont les limites élargies sont entièrement dans la zone ne contient que des éléments retenus :
+     * tout son sous-arbre est alors transmis à f sans aucun test, après un appel à reserve(nombre d'éléments).
+     *
+     * @return false si la recherche a été interrompue par f.
+     */
+    template<bool Inscribed, typename F, typename R = SNoReserve>
+    bool forEachIn(std::uint32_t index, const SLimits& limits, F&& f, R&& reserve = {}) const
+    {
+        const SNode& node = m_nodes[index];
+        if (!overlap(node.loose, limits)) {
+            return true;
+        }
+        if (isFullyInside(node.loose, limits)) {
+            reserve(node.count);
+            return forEachAllIn(index, f);
+        }
+
+        for (std::size_t first = 0; first < node.ids.size(); first += CBoxFilter::BATCH) {
+            const std::size_t count = std::min(CBoxFilter::BATCH, node.ids.size() - first);
+            const std::uint64_t mask = Inscribed
+                ? CBoxFilter::insideMask(node.bounds, first, count, limits.x1, limits.y1, limits.x2, limits.y2)
+                : CBoxFilter::overlapMask(node.bounds, first, count, limits.x1, limits.y1, limits.x2, limits.y2);
+            if (!CBoxFilter::forEachBit(mask, first, [&](std::size_t i) { return visit(f, m_items[node.ids[i]]); })) {
+                return false;
+            }
+        }
+
+        if (node.hasChildren()) {
+            for (std::uint32_t i = 0; i < 4; i++) {
+                if (!forEachIn<Inscribed>(node.firstChild + i, limits, f, reserve)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief forEachColliding appliqué au sous-arbre du nœud 'index', en visitant d'abord les enfants
+     *        les plus proches du point (cx, cy), pour les recherches qui s'arrêtent aux premiers résultats.
+     *
+     * @return false si la recherche a été interrompue par f.
+     */
+    template<typename F>
+    bool collidingNearFirst(std::uint32_t index, const SLimits& limits, float cx, float cy, F& f) const
+    {
+        const SNode& node = m_nodes[index];
+        if (node.count == 0 || !overlap(node.loose, limits)) {
+            return true;
+        }
+        if (isFullyInside(node.loose, limits)) {
+            return forEachAllIn(index, f);
+        }
+
+        for (std::size_t first = 0; first < node.ids.size(); first += CBoxFilter::BATCH) {
+            const std::size_t count = std::min(CBoxFilter::BATCH, node.ids.size() - first);
+            const std::uint64_t mask = CBoxFilter::overlapMask(node.bounds, first, count, limits.x1, limits.y1, limits.x2, limits.y2);
+            if (!CBoxFilter::forEachBit(mask, first, [&](std::size_t i) { return visit(f, m_items[node.ids[i]]); })) {
+                return false;
+            }
+        }
+
+        if (node.hasChildren()) {
+            // Tri par insertion des 4 enfants selon la distance de leurs limites élargies au centre
+            std::pair<float, std::uint32_t> children[4];
+            for (std::uint32_t i = 0; i < 4; i++) {
+                const std::uint32_t child = node.firstChild + i;
+                const float d2 = distance2(m_nodes[child].loose, cx, cy);
+                std::uint32_t k = i;
+                for (; k > 0 && children[k - 1].first > d2; --k) {
+                    children[k] = children[k - 1];
+                }
+                children[k] = { d2, child };
+            }
+            for (const auto& child : children) {
+                if (!collidingNearFirst(child.second, limits, cx, cy, f)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief countInscribed (Inscribed) ou countColliding appliqué au sous-arbre du nœud 'index'.
+     *
+     * Un nœud entièrement dans la zone compte pour son compteur de sous-arbre, sans descendre plus bas.
+     */
+    template<bool Inscribed>
+    std::size_t countIn(std::uint32_t index, const SLimits& limits) const
+    {
+        const SNode& node = m_nodes[index];
+        if (!overlap(node.loose, limits)) {
+            return 0;
+        }
+        if (isFullyInside(node.loose, limits)) {
+            return node.count;
+        }
+
+        std::size_t result = 0;
+        for (std::size_t first = 0; first < node.ids.size(); first += CBoxFilter::BATCH) {
+            const std::size_t count = std::min(CBoxFilter::BATCH, node.ids.size() - first);
+            const std::uint64_t mask = Inscribed
+                ? CBoxFilter::insideMask(node.bounds, first, count, limits.x1, limits.y1, limits.x2, limits.y2)
+                : CBoxFilter::overlapMask(node.bounds, first, count, limits.x1, limits.y1, limits.x2, limits.y2);
+            result += static_cast<std::size_t>(std::popcount(mask));
+        }
+
+        if (node.hasChildren()) {
+            for (std::uint32_t i = 0; i < 4; i++) {
+                result += countIn<Inscribed>(node.firstChild + i, limits);
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief findCollidingBatch appliqué au sous-arbre du nœud 'index'.
+     *
+     * active[begin, fin) contient les indices des requêtes dont la zone touche les limites élargies du nœud.
+     * Les requêtes qui couvrent le nœud reçoivent tout le sous-arbre sans test ; les autres filtrent les éléments
+     * du nœud lot par lot (chaque lot est chargé une fois pour toutes les requêtes), puis sont réparties entre
+     * les enfants en ajoutant à la fin de active les requêtes de chaque enfant.
+     *
+     * @return false si la recherche a été interrompue par f.
+     */
+    template<typename F>
+    bool batchIn(std::uint32_t index, std::span<const SLimits> queries, std::vector<std::size_t>& active, std::size_t begin, F& f) const
+    {
+        const SNode& node = m_nodes[index];
+        std::size_t end = active.size();
+
+        // Les requêtes couvrant le nœud sont traitées immédiatement puis retirées de l'ensemble
+        for (std::size_t a = begin; a < end;) {
+            const std::size_t q = active[a];
+            if (isFullyInside(node.loose, queries[q])) {
+                if (!forEachAllIn(index, [&f, q](const T& t) { return visit(f, t, q); })) {
+                    return false;
+                }
+                active[a] = active[--end];
+            }
+            else {
+                ++a;
+            }
+        }
+        active.resize(end);
+        if (begin == end) {
+            return true;
+        }
+
+        for (std::size_t first = 0; first < node.ids.size(); first += CBoxFilter::BATCH) {
+            const std::size_t count = std::min(CBoxFilter::BATCH, node.ids.size() - first);
+            for (std::size_t a = begin; a < end; ++a) {
+                const std::size_t q = active[a];
+                const SLimits& limits = queries[q];
+                const std::uint64_t mask = CBoxFilter::overlapMask(node.bounds, first, count, limits.x1, limits.y1, limits.x2, limits.y2);
+                if (!CBoxFilter::forEachBit(mask, first, [&](std::size_t i) { return visit(f, m_items[node.ids[i]], q); })) {
+                    return false;
+                }
+            }
+        }
+
+        if (node.hasChildren()) {
+            for (std::uint32_t i = 0; i < 4; i++) {
+                const SNode& child = m_nodes[node.firstChild + i];
+                if (child.count == 0) {
+                    continue;
+                }
+                for (std::size_t a = begin; a < end; ++a) {
+                    if (overlap(child.loose, queries[active[a]])) {
+                        active.push_back(active[a]);
+                    }
+                }
+                if (active.size() > end && !batchIn(node.firstChild + i, queries, active, end, f)) {
+                    return false;
+                }
+                active.resize(end);
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Index de balayage (sweep and prune) des nœuds, construit une fois par recherche de paires.
+     */
+    struct SSweepIndex
+    {
+        const TQuadTree* tree;                  ///< QuadTree indexé
+        std::vector<std::uint32_t> order;       ///< Pour chaque nœud, indices locaux de ses éléments triés par x1 croissant
+        std::vector<std::size_t> offsets;       ///< Début de chaque nœud dans order (offsets[nœud + 1] en marque la fin)
+        std::vector<SLimits> itemsBounds;       ///< Enveloppe des éléments propres de chaque nœud
+    };
+
+    /**
+     * @brief Construit l'index de balayage de tous les nœuds.
+     */
+    SSweepIndex sweepIndex() const
+    {
+        SSweepIndex index;
+        index.tree = this;
+        index.order.reserve(size());
+        index.offsets.reserve(m_nodes.size() + 1);
+        index.itemsBounds.reserve(m_nodes.size());
+        for (const SNode& node : m_nodes) {
+            const std::size_t begin = index.order.size();
+            index.offsets.push_back(begin);
+            SLimits envelope = node.loose;
+            for (std::uint32_t i = 0; i < node.ids.size(); ++i) {
+                index.order.push_back(i);
+                const SLimits b = node.boundsAt(i);
+                if (i == 0) {
+                    envelope = b;
+                }
+                else {
+                    envelope = { std::min(envelope.x1, b.x1), std::min(envelope.y1, b.y1),
+                                 std::max(envelope.x2, b.x2), std::max(envelope.y2, b.y2) };
+                }
+            }
+            const float* x1 = node.bounds.x1();
+            std::sort(index.order.begin() + begin, index.order.end(),
+                [x1](std::uint32_t a, std::uint32_t b) { return x1[a] < x1[b]; });
+            index.itemsBounds.push_back(envelope);
+        }
+        index.offsets.push_back(index.order.size());
+        return index;
+    }
+
+    /**
+     * @brief Éléments propres du nœud 'index', dans l'ordre de balayage.
+     */
+    template<typename S>
+    static std::span<const std::uint32_t> sweepOrder(const S& sweep, std::uint32_t index)
+    {
+        return { sweep.order.data() + sweep.offsets[index], sweep.order.data() + sweep.offsets[index + 1] };
+    }
+
+    /**
+     * @brief Paires en collision parmi les éléments propres du nœud 'index', par balayage selon x.
+     *
+     * @return false si la recherche a été interrompue par f.
+     */
+    template<typename F>
+    bool sweepSelf(const SSweepIndex& sweep, std::uint32_t index, F& f) const
+    {
+        const SNode& node = m_nodes[index];
+        const std::span<const std::uint32_t> order = sweepOrder(sweep, index);
+        for (std::size_t i = 0; i < order.size(); ++i) {
+            const SLimits a = node.boundsAt(order[i]);
+            // Les éléments suivants commencent après a.x1 : ils touchent a selon x tant qu'ils commencent avant a.x2
+            for (std::size_t j = i + 1; j < order.size() && node.bounds.x1()[order[j]] <= a.x2; ++j) {
+                const SLimits b = node.boundsAt(order[j]);
+                if (b.y1 <= a.y2 && a.y1 <= b.y2 && !visit(f, m_items[node.ids[order[i]]], m_items[node.ids[order[j]]])) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Paires en collision entre les éléments propres du nœud na de sa et ceux du nœud nb de sb
+     *        (deux nœuds distincts, éventuellement de deux QuadTree différents), par balayage selon x
+     *        des deux listes triées.
+     *
+     * f reçoit toujours l'élément de sa en premier.
+     *
+     * @return false si la recherche a été interrompue par f.
+     */
+    template<typename SA, typename SB, typename F>
+    static bool sweepPairs(const SA& sa, std::uint32_t na, const SB& sb, std::uint32_t nb, F& f)
+    {
+        const auto& nodeA = sa.tree->m_nodes[na];
+        const auto& nodeB = sb.tree->m_nodes[nb];
+        const auto& itemsA = sa.tree->m_items;
+        const auto& itemsB = sb.tree->m_items;
+        const std::span<const std::uint32_t> orderA = sweepOrder(sa, na);
+        const std::span<const std::uint32_t> orderB = sweepOrder(sb, nb);
+        const float* x1A = nodeA.bounds.x1();
+        const float* x1B = nodeB.bounds.x1();
+
+        std::size_t i = 0;
+        std::size_t j = 0;
+        while (i < orderA.size() && j < orderB.size()) {
+            // L'élément qui commence le plus tôt est comparé aux éléments de l'autre liste qui commencent avant sa fin
+            if (x1A[orderA[i]] <= x1B[orderB[j]]) {
+                const SLimits la = nodeA.boundsAt(orderA[i]);
+                for (std::size_t k = j; k < orderB.size() && x1B[orderB[k]] <= la.x2; ++k) {
+                    const SLimits lb = nodeB.boundsAt(orderB[k]);
+                    if (lb.y1 <= la.y2 && la.y1 <= lb.y2 && !visit(f, itemsA[nodeA.ids[orderA[i]]], itemsB[nodeB.ids[orderB[k]]])) {
+                        return false;
+                    }
+                }
+                ++i;
+            }
+            else {
+                const SLimits lb = nodeB.boundsAt(orderB[j]);
+                for (std::size_t k = i; k < orderA.size() && x1A[orderA[k]] <= lb.x2; ++k) {
+                    const SLimits la = nodeA.boundsAt(orderA[k]);
+                    if (lb.y1 <= la.y2 && la.y1 <= lb.y2 && !visit(f, itemsA[nodeA.ids[orderA[k]]], itemsB[nodeB.ids[orderB[j]]])) {
+                        return false;
+                    }
+                }
+                ++j;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Paires en collision entre les éléments propres du nœud 'owner' de sa et ceux du sous-arbre
+     *        du nœud 'index' de sb (qui ne contient pas owner).
+     *
+     * @return false si la recherche a été interrompue par f.
+     */
+    template<typename SA, typename SB, typename F>
+    static bool pairsWithSubtree(const SA& sa, std::uint32_t owner, const SB& sb, std::uint32_t index, F& f)
+    {
+        const auto& node = sb.tree->m_nodes[index];
+        if (node.count == 0 || !overlap(sa.itemsBounds[owner], node.loose)) {
+            return true;
+        }
+        if (!node.ids.empty() && !sweepPairs(sa, owner, sb, index, f)) {
+            return false;
+        }
+        if (node.hasChildren()) {
+            for (std::uint32_t i = 0; i < 4; i++) {
+                if (!pairsWithSubtree(sa, owner, sb, node.firstChild + i, f)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Paires en collision entre le sous-arbre du nœud a de sa et celui du nœud b de sb
+     *        (deux sous-arbres disjoints, éventuellement de deux QuadTree différents).
+     *
+     * Les paires de nœuds dont les limites élargies ne se touchent pas sont ignorées.
+     * f reçoit toujours l'élément de sa en premier.
+     *
+     * @return false si la recherche a été interrompue par f.
+     */
+    template<typename SA, typename SB, typename F>
+    static bool pairsBetween(const SA& sa, std::uint32_t a, const SB& sb, std::uint32_t b, F& f)
+    {
+        const auto& nodeA = sa.tree->m_nodes[a];
+        const auto& nodeB = sb.tree->m_nodes[b];
+        if (nodeA.count == 0 || nodeB.count == 0 || !overlap(nodeA.loose, nodeB.loose)) {
+            return true;
+        }
+        // Éléments propres de a contre tout le sous-arbre de b, puis éléments propres de b contre les enfants de a
+        if (!nodeA.ids.empty() && !pairsWithSubtree(sa, a, sb, b, f)) {
+            return false;
+        }
+        if (!nodeA.hasChildren()) {
+            return true;
+        }
+        if (!nodeB.ids.empty()) {
+            auto swapped = [&f](const auto& itemB, const auto& itemA) { return visit(f, itemA, itemB); };
+            for (std::uint32_t i = 0; i < 4; i++) {
+                if (!pairsWithSubtree(sb, b, sa, nodeA.firstChild + i, swapped)) {
+                    return false;
+                }
+            }
+        }
+        if (nodeB.hasChildren()) {
+            for (std::uint32_t i = 0; i < 4; i++) {
+                for (std::uint32_t j = 0; j < 4; j++) {
+                    if (!pairsBetween(sa, nodeA.firstChild + i, sb, nodeB.firstChild + j, f)) {
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief forEachCollidingPair appliqué au sous-arbre du nœud 'index'.
+     *
+     * @return false si la recherche a été interrompue par f.
+     */
+    template<typename F>
+    bool pairsIn(const SSweepIndex& sweep, std::uint32_t index, F& f) const
+    {
+        const SNode& node = m_nodes[index];
+        if (node.count < 2) {
+            return true;
+        }
+        if (!sweepSelf(sweep, index, f)) {
+            return false;
+        }
+        if (!node.hasChildren()) {
+            return true;
+        }
+        for (std::uint32_t i = 0; i < 4; i++) {
+            if (!node.ids.empty() && !pairsWithSubtree(sweep, index, sweep, node.firstChild + i, f)) {
+                return false;
+            }
+            // Des éléments de deux enfants voisins peuvent se toucher sur leur bord commun (ou plus, en mode lâche)
+            for (std::uint32_t j = i + 1; j < 4; j++) {
+                if (!pairsBetween(sweep, node.firstChild + i, sweep, node.firstChild + j, f)) {
+                    return false;
+                }
+            }
+            if (!pairsIn(sweep, node.firstChild + i, f)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Premier élément rencontré dans le sous-arbre non vide du nœud 'index', en descendant au plus court.
+     */
+    const T* representativeOf(std::uint32_t index) const
+    {
+        while (m_nodes[index].ids.empty()) {
+            std::uint32_t child = m_nodes[index].firstChild;
+            while (m_nodes[child].count == 0) {
+                ++child;
+            }
+            index = child;
+        }
+        return &m_items[m_nodes[index].ids.front()];
+    }
+
+    /**
+     * @brief forEachCollidingLod appliqué au sous-arbre du nœud 'index'.
+     *
+     * @return false si la recherche a été interrompue par f ou g.
+     */
+    template<typename F, typename G>
+    bool lodIn(std::uint32_t index, const SLimits& limits, float minSize, F& f, G& g) const
+    {
+        const SNode& node = m_nodes[index];
+        if (node.count == 0 || !overlap(node.loose, limits)) {
+            return true;
+        }
+        if (node.count > 1 && node.loose.x2 - node.loose.x1 < minSize && node.loose.y2 - node.loose.y1 < minSize) {
+            return visit(g, SAggregate{ node.loose, node.count, representativeOf(index) });
+        }
+
+        for (std::size_t first = 0; first < node.ids.size(); first += CBoxFilter::BATCH) {
+            const std::size_t count = std::min(CBoxFilter::BATCH, node.ids.size() - first);
+            const std::uint64_t mask = CBoxFilter::overlapMask(node.bounds, first, count, limits.x1, limits.y1, limits.x2, limits.y2);
+            if (!CBoxFilter::forEachBit(mask, first, [&](std::size_t i) { return visit(f, m_items[node.ids[i]]); })) {
+                return false;
+            }
+        }
+
+        if (node.hasChildren()) {
+            for (std::uint32_t i = 0; i < 4; i++) {
+                if (!lodIn(node.firstChild + i, limits, minSize, f, g)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Carré de la distance du point (x, y) au rectangle l (nulle si le point est dedans).
+     */
+    static float distance2(const SLimits& l, float x, float y) noexcept
+    {
+        const float dx = std::max({ l.x1 - x, 0.0f, x - l.x2 });
+        const float dy = std::max({ l.y1 - y, 0.0f, y - l.y2 });
+        return dx * dx + dy * dy;
+    }
+
+    /**
+     * @brief Nœud ou élément en attente dans la file de findNearest.
+     */
+    struct SNearestEntry
+    {
+        float distance2;        ///< Carré de la distance au point recherché (minorant pour un nœud)
+        std::uint32_t index;    ///< Indice du nœud dans m_nodes, ou de l'élément dans m_items
+        bool item;              ///< Élément ou nœud
+
+        /**
+         * @brief Ordre de la file de priorité : la plus petite distance en tête, les éléments avant les nœuds.
+         */
+        bool operator<(const SNearestEntry& other) const noexcept
+        {
+            return distance2 != other.distance2 ? distance2 > other.distance2 : item < other.item;
+        }
+    };
+
+    /**
+     * @brief Rayon (ou segment) origin + t * dir, pour t dans [0, maxT].
+     */
+    struct SRay
+    {
+        float ox, oy;           ///< Origine
+        float dx, dy;           ///< Direction (non normalisée : t s'exprime en multiples de dir)
+        float maxT;             ///< Paramètre maximal
+        float invDx, invDy;     ///< Inverses de la direction, pour le test des dalles
+    };
+
+    /**
+     * @brief Test des dalles (slab test) du rayon contre le rectangle l.
+     *
+     * @param tEnter Reçoit le paramètre d'entrée du rayon dans l (0 si l'origine est dedans).
+     * @return true si le rayon touche l pour un t dans [0, maxT].
+     */
+    static bool slabTest(const SLimits& l, const SRay& ray, float& tEnter) noexcept
+    {
+        float tMin = 0.0f;
+        float tMax = ray.maxT;
+        // Axe par axe : un rayon parallèle à l'axe doit partir de l'intérieur de la dalle
+        if (ray.dx == 0.0f) {
+            if (ray.ox < l.x1 || ray.ox > l.x2) {
+                return false;
+            }
+        }
+        else {
+            float t1 = (l.x1 - ray.ox) * ray.invDx;
+            float t2 = (l.x2 - ray.ox) * ray.invDx;
+            tMin = std::max(tMin, std::min(t1, t2));
+            tMax = std::min(tMax, std::max(t1, t2));
+        }
+        if (ray.dy == 0.0f) {
+            if (ray.oy < l.y1 || ray.oy > l.y2) {
+                return false;
+            }
+        }
+        else {
+            float t1 = (l.y1 - ray.oy) * ray.invDy;
+            float t2 = (l.y2 - ray.oy) * ray.invDy;
+            tMin = std::max(tMin, std::min(t1, t2));
+            tMax = std::min(tMax, std::max(t1, t2));
+        }
+        tEnter = tMin;
+        return tMin <= tMax;
+    }
+
+    static SRay makeRay(float ox, float oy, float dx, float dy, float maxT) noexcept
+    {
+        return { ox, oy, dx, dy, maxT, 1.0f / dx, 1.0f / dy };
+    }
+
+    /**
+     * @brief Enfants non vides du nœud 'index' touchés par le rayon, triés par paramètre d'entrée croissant.
+     *
+     * @return Le nombre d'enfants écrits dans children (au plus 4).
+     */
+    std::size_t childrenAlongRay(std::uint32_t index, const SRay& ray, std::pair<float, std::uint32_t>(&children)[4]) const
+    {
+        const SNode& node = m_nodes[index];
+        std::size_t n = 0;
+        if (node.hasChildren()) {
+            for (std::uint32_t i = 0; i < 4; i++) {
+                const std::uint32_t child = node.firstChild + i;
+                float tEnter;
+                if (m_nodes[child].count > 0 && slabTest(m_nodes[child].loose, ray, tEnter)) {
+                    // Tri par insertion : au plus 4 éléments
+                    std::size_t k = n++;
+                    for (; k > 0 && children[k - 1].first > tEnter; --k) {
+                        children[k] = children[k - 1];
+                    }
+                    children[k] = { tEnter, child };
+                }
+            }
+        }
+        return n;
+    }
+
+    /**
+     * @brief raycast appliqué au sous-arbre du nœud 'index', déjà reconnu comme touché par le rayon.
+     *
+     * @return false si le parcours a été interrompu par f.
+     */
+    template<typename F>
+    bool raycastIn(std::uint32_t index, const SRay& ray, F&& f) const
+    {
+        const SNode& node = m_nodes[index];
+        for (std::size_t i = 0; i < node.ids.size(); ++i) {
+            float t;
+            if (slabTest(node.boundsAt(i), ray, t) && !visit(f, m_items[node.ids[i]], t)) {
+                return false;
+            }
+        }
+
+        std::pair<float, std::uint32_t> children[4];
+        const std::size_t n = childrenAlongRay(index, ray, children);
+        for (std::size_t c = 0; c < n; ++c) {
+            if (!raycastIn(children[c].second, ray, f)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief raycastFirst appliqué au sous-arbre du nœud 'index' : met à jour bestT et best si un élément plus proche est touché.
+     */
+    void raycastFirstIn(std::uint32_t index, const SRay& ray, float& bestT, std::uint32_t& best) const
+    {
+        const SNode& node = m_nodes[index];
+        for (std::size_t i = 0; i < node.ids.size(); ++i) {
+            float t;
+            if (slabTest(node.boundsAt(i), ray, t) && t < bestT) {
+                bestT = t;
+                best = node.ids[i];
+            }
+        }
+
+        // Les enfants sont visités d'avant en arrière : ceux où le rayon entre après le meilleur élément sont ignorés
+        std::pair<float, std::uint32_t> children[4];
+        const std::size_t n = childrenAlongRay(index, ray, children);
+        for (std::size_t c = 0; c < n && children[c].first < bestT; ++c) {
+            raycastFirstIn(children[c].second, ray, bestT, best);
+        }
+    }
+
+public:
+    /**
+     * @brief Constructeur de la classe TQuadTree.
+     *
+     * @param limits Les limites géométriques du QuadTree.
+     */
+    TQuadTree(const SLimits& limits = { 0.0f,0.0f,1.0f,1.0f })
+        : m_limits(limits)
+    {
+        //Evidemment, il va falloir compléter ce constructeur pour qu'il initialise correctement votre TQuadTree
+        m_nodes.emplace_back(limits);
+    }
+
+    /**
+     * @brief Constructeur avec paramètres de subdivision.
+     *
+     * @param limits Les limites géométriques du QuadTree.
+     * @param config La capacité des feuilles, la profondeur maximale, le critère de subdivision et l'élargissement des nœuds.
+     * @throws std::invalid_argument Si la capacité ou la profondeur maximale est nulle, si areaRatio n'est pas dans ]0, 1]
+     *         ou si looseness est inférieur à 1.
+     */
+    TQuadTree(const SLimits& limits, const SQuadTreeConfig& config)
+        : m_limits(limits), m_config(config)
+    {
+        if (config.capacity == 0 || config.maxDepth == 0) {
+            throw std::invalid_argument("QuadTree capacity and maxDepth must be positive");
+        }
+        if (!(config.areaRatio > 0.0f && config.areaRatio <= 1.0f)) {
+            throw std::invalid_argument("QuadTree areaRatio must be in (0, 1]");
+        }
+        if (!(config.looseness >= 1.0f)) {
+            throw std::invalid_argument("QuadTree looseness must be at least 1");
+        }
+        m_nodes.emplace_back(limits, loosen(limits));
+    }
+
+    /**
+     * @brief Constructeur par chargement en bloc.
+     *
+     * Construit l'arbre en une passe à partir des éléments de [first, last) : les éléments sont répartis
+     * récursivement par quadrant et chaque nœud n'est construit qu'une fois. Le résultat est identique
+     * à l'insertion successive des éléments dans le même ordre.
+     *
+     * @param limits Les limites géométriques du QuadTree.
+     * @param first, last Les éléments à insérer.
+     * @param config La capacité des feuilles, la profondeur maximale, le critère de subdivision et l'élargissement des nœuds.
+     * @throws std::domain_error Si un élément est en dehors des limites du QuadTree.
+     */
+    template<std::input_iterator It>
+        requires std::convertible_to<std::iter_reference_t<It>, T>
+    TQuadTree(const SLimits& limits, It first, It last, const SQuadTreeConfig& config = {})
+        : TQuadTree(limits, config)
+    {
+        bulkLoad(first, last);
+    }
+
+    /**
+     * @brief Constructeur de copie.
+     *
+     * L'arène et la réserve d'éléments étant adressées par indices, les copier suffit à copier l'arbre.
+     * La copie reçoit sa propre génération.
+     */
+    TQuadTree(const TQuadTree& other)
+        : m_nodes(other.m_nodes)
+        , m_limits(other.m_limits)
+        , m_config(other.m_config)
+        , m_items(other.m_items)
+        , m_freeItems(other.m_freeItems)
+        , m_freeGroups(other.m_freeGroups)
+    {
+    }
+
+    /**
+     * @brief Opérateur d'affectation par copie.
+     */
+    TQuadTree& operator=(const TQuadTree& other)
+    {
+        if (this != &other) {
+            m_nodes = other.m_nodes;
+            m_limits = other.m_limits;
+            m_config = other.m_config;
+            m_items = other.m_items;
+            m_freeItems = other.m_freeItems;
+            m_freeGroups = other.m_freeGroups;
+            m_generation = nextGeneration();
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Constructeur de déplacement.
+     *
+     * Reprend l'arène et la réserve d'éléments de other sans les copier ni rien allouer. other devient un QuadTree
+     * vide de mêmes limites et paramètres, sans racine : elle ne sera recréée que s'il est de nouveau modifié.
+     */
+    TQuadTree(TQuadTree&& other) noexcept
+        : m_nodes(std::move(other.m_nodes))
+        , m_limits(other.m_limits)
+        , m_config(other.m_config)
+        , m_items(std::move(other.m_items))
+        , m_freeItems(std::move(other.m_freeItems))
+        , m_freeGroups(std::move(other.m_freeGroups))
+    {
+        other.m_generation = nextGeneration();
+        other.m_nodes.clear();
+        other.m_items.clear();
+        other.m_freeItems.clear();
+        other.m_freeGroups.clear();
+    }
+
+    /**
+     * @brief Opérateur d'affectation par déplacement : échange le contenu des deux QuadTree.
+     */
+    TQuadTree& operator=(TQuadTree&& other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+
+    /**
+     * @brief Échange le contenu (éléments, limites et paramètres) de deux QuadTree, sans copie.
+     */
+    void swap(TQuadTree& other) noexcept
+    {
+        m_nodes.swap(other.m_nodes);
+        std::swap(m_limits, other.m_limits);
+        std::swap(m_config, other.m_config);
+        m_items.swap(other.m_items);
+        m_freeItems.swap(other.m_freeItems);
+        m_freeGroups.swap(other.m_freeGroups);
+        // Les deux contenus sont nouveaux pour chacun des deux QuadTree
+        m_generation = nextGeneration();
+        other.m_generation = nextGeneration();
+    }
+
+    friend void swap(TQuadTree& a, TQuadTree& b) noexcept
+    {
+        a.swap(b);
+    }
+
+    /**
+     * @brief Appelle f(itemA, itemB) pour chaque paire d'un élément de a et d'un élément de b en collision.
+     *
+     * Les deux arbres sont parcourus ensemble : une paire de nœuds dont les limites élargies ne se touchent pas
+     * est ignorée avec tout ce qu'elle contient, au lieu d'interroger b une fois par élément de a.
+     * Les limites des deux QuadTree peuvent être différentes, tout comme leur configuration et le type des éléments.
+     * Les listes d'éléments sont comparées par balayage selon x, comme pour forEachCollidingPair.
+     * S'il retourne un booléen, false interrompt la recherche.
+     *
+     * @param a, b Les deux QuadTree.
+     * @param f Le visiteur, qui reçoit toujours l'élément de a en premier.
+     * @return false si la recherche a été interrompue par f.
+     */
+    template<QuadTreeData U, typename F>
+        requires std::invocable<F&, const T&, const U&>
+    friend bool spatialJoin(const TQuadTree& a, const TQuadTree<U>& b, F&& f)
+    {
+        if (a.size() == 0 || b.size() == 0) {
+            return true;
+        }
+        const auto sweepA = a.sweepIndex();
+        const auto sweepB = b.sweepIndex();
+        return pairsBetween(sweepA, ROOT, sweepB, ROOT, f);
+    }
+
+    /**
+     * @brief Retourne les limites géométriques de ce QuadTree
+     */
+    SLimits limits() const
+    {
+        //Evidemment, il va falloir compléter cette fonction pour qu'elle retourne les limites géométriques de ce QuadTree
+        return m_limits;
+    }
+
+    /**
+     * @brief Retourne les paramètres de subdivision de ce QuadTree
+     */
+    const SQuadTreeConfig& config() const noexcept
+    {
+        return m_config;
+    }
+
+    /**
+     * @brief Retourne la génération du contenu de ce QuadTree.
+     *
+     * Elle change à chaque construction et à chaque modification (insertion, suppression, vidage, chargement,
+     * affectation, échange), en prenant une valeur d'un compteur commun à tous les QuadTree : un même couple
+     * (QuadTree, génération) n'est jamais vu pour deux contenus différents, même par un QuadTree recréé à la même
+     * adresse. Les résultats peuvent donc être gardés en cache (voir TViewportQuery).
+     */
+    std::uint64_t generation() const noexcept
+    {
+        return m_generation;
+    }
+
+    /**
+     * @brief Vérifie si le QuadTree est vide.
+     *
+     * Cette fonction vérifie si le QuadTree ne contient aucun élément de données, y compris dans la descendance.
+     *
+     * @return true si le QuadTree est vide, false sinon.
+     */
+    bool empty() const
+    {
+        //Evidemment, il va falloir compléter cette fonction pour qu'elle retourne true uniquement si le QuadTree est vide
+        return (size() == 0);
+    }
+
+    /**
+     * @brief Retourne la profondeur maximale du QuadTree.
+     *
+     * La profondeur maximale du QuadTree correspond nombre maximal de niveaux de descendants.
+     */
+    size_t depth() const
+    {
+        //Evidemment, il va falloir compléter cette fonction pour qu'elle retourne la profondeur maximale du QuadTree
+        return m_nodes.empty() ? 1 : depthOf(ROOT);
+    }
+
+    /**
+     * @brief Retourne le nombre de nœuds du QuadTree, racine comprise (hors groupes libérés en attente de réutilisation).
+     */
+    size_t nodeCount() const noexcept
+    {
+        return m_nodes.empty() ? 1 : m_nodes.size() - 4 * m_freeGroups.size();
+    }
+
+    /**
+     * @brief Retourne le nombre d'éléments stockés dans le QuadTree.
+     *
+     * Cette fonction retourne le nombre d'éléments stockés dans le QuadTree en incluant toute la descendance.
+     * Chaque nœud tient à jour le nombre d'éléments de son sous-arbre : l'appel est en temps constant.
+     *
+     * @return Le nombre d'éléments stockés dans le QuadTree.
+     */
+    size_t size() const
+    {
+        //Evidemment, il va falloir compléter cette fonction pour qu'elle retourne le nombre d'éléments stockés dans le QuadTree
+        return m_nodes.empty() ? 0 : m_nodes[ROOT].count;
+    }
+
+    /**
+  * @brief Insère un élément dans le QuadTree.
+  *
+  * Cette fonction insère l'élément donné dans le QuadTree. Si le nœud courant a des enfants,
+  * elle essaie d'insérer l'élément dans un enfant approprié. Sinon, elle stocke l'élément dans le nœud courant.
+  *
+  * Si le nombre d'éléments dépasse la capacité ou si un élément peut être entièrement contenu dans un enfant,
+  * le nœud est subdivisé (voir SQuadTreeConfig pour les autres critères).
+  *
+  * @param t L'élément à insérer.
+  * @throws std::domain_error Si l'élément est en dehors des limites du QuadTree.
+  */
+    void insert(const T& t)
+    {
+        SLimits r = boundsOf(t);
+
+        // Vérifie si l'élément est dans les limites du QuadTree
+        if (!isFullyInside(r, m_limits)) {
+            throw std::domain_error("Object out of quadtree bounds");
+        }
+
+        ensureRoot();
+        insertInto(ROOT, 1, allocateItem(t), r);
+        m_generation = nextGeneration();
+    }
+
+    /**
+     * @brief Insère un élément dans le QuadTree en le déplaçant dans la réserve, sans copie.
+     *
+     * @param t L'élément à insérer.
+     * @throws std::domain_error Si l'élément est en dehors des limites du QuadTree (t n'est alors pas déplacé).
+     */
+    void insert(T&& t)
+    {
+        SLimits r = boundsOf(t);
+        if (!isFullyInside(r, m_limits)) {
+            throw std::domain_error("Object out of quadtree bounds");
+        }
+        ensureRoot();
+        insertInto(ROOT, 1, allocateItem(std::move(t)), r);
+        m_generation = nextGeneration();
+    }
+
+    /**
+     * @brief Construit un élément à partir de args directement dans la réserve (sans T intermédiaire) et l'insère.
+     *
+     * @throws std::domain_error Si l'élément est en dehors des limites du QuadTree (sa case est alors libérée).
+     */
+    template<typename... Args>
+        requires std::constructible_from<T, Args...>
+    void emplace(Args&&... args)
+    {
+        ensureRoot();
+        const std::uint32_t id = emplaceItem(std::forward<Args>(args)...);
+        const SLimits r = boundsOf(m_items[id]);
+        if (!isFullyInside(r, m_limits)) {
+            releaseItem(id);
+            throw std::domain_error("Object out of quadtree bounds");
+        }
+        insertInto(ROOT, 1, id, r);
+        m_generation = nextGeneration();
+    }
+
+
+    /**
+     * @brief Remplace le contenu du QuadTree par les éléments de range, chargés en bloc.
+     *
+     * Voir le constructeur par chargement en bloc.
+     *
+     * @throws std::domain_error Si un élément est en dehors des limites du QuadTree (l'arbre n'est alors pas modifié).
+     */
+    template<std::ranges::input_range R>
+        requires std::convertible_to<std::ranges::range_reference_t<R>, T>
+    void build(R&& range)
+    {
+        bulkLoad(std::ranges::begin(range), std::ranges::end(range));
+    }
+
+    /**
+     * @brief Vide le QuadTree.
+     *
+     * Cette fonction vide le QuadTree de toutes ses données.
+     * La capacité de l'arène est conservée pour les insertions suivantes.
+     */
+    void clear()
+    {
+        //Evidemment, il va falloir compléter cette fonction pour qu'elle vide le QuadTree
+        ensureRoot();
+        m_nodes.erase(m_nodes.begin() + 1, m_nodes.end());
+        m_nodes[ROOT].clearItems();
+        m_nodes[ROOT].firstChild = NO_CHILDREN;
+        m_nodes[ROOT].count = 0;
+        m_items.clear();
+        m_freeItems.clear();
+        m_freeGroups.clear();
+        m_generation = nextGeneration();
+    }
+
+    /**
+     * @brief Compacte le QuadTree : regroupe tous les nœuds qui peuvent l'être (voir SQuadTreeConfig::mergeThreshold),
+     *        puis renumérote l'arène et la réserve d'éléments sans les cases libres, et libère la mémoire en trop.
+     *
+     * Le contenu est inchangé, mais les pointeurs vers les éléments (pointer_container, firstColliding...)
+     * sont invalidés.
+     */
+    void compact()
+    {
+        if (m_nodes.empty()) {
+            return;
+        }
+        mergeAllIn(ROOT);
+
+        // Parcours en largeur : chaque groupe de 4 enfants reste contigu dans la nouvelle arène
+        std::vector<SNode> nodes;
+        nodes.reserve(nodeCount());
+        TItemSlab<T> items;
+        items.reserve(size());
+        nodes.push_back(std::move(m_nodes[ROOT]));
+        for (std::size_t index = 0; index < nodes.size(); ++index) {
+            for (std::uint32_t& id : nodes[index].ids) {
+                items.push_back(std::move(m_items[id]));
+                id = static_cast<std::uint32_t>(items.size() - 1);
+            }
+            if (nodes[index].hasChildren()) {
+                const std::uint32_t first = nodes[index].firstChild;
+                nodes[index].firstChild = static_cast<std::uint32_t>(nodes.size());
+                for (std::uint32_t i = 0; i < 4; i++) {
+                    nodes.push_back(std::move(m_nodes[first + i]));
+                }
+            }
+        }
+        m_nodes.swap(nodes);
+        m_items.swap(items);
+        m_freeItems.clear();
+        m_freeItems.shrink_to_fit();
+        m_freeGroups.clear();
+        m_freeGroups.shrink_to_fit();
+        m_generation = nextGeneration();
+    }
+
+    /**
+     * @brief Retire un élément du QuadTree.
+     *
+     * Si les descendants d'un nœud du chemin ne comptent plus qu'au plus SQuadTreeConfig::mergeThreshold éléments
+     * (aucun par défaut), ils sont regroupés dans ce nœud et leurs groupes d'enfants sont libérés pour être réutilisés.
+     * La case de l'élément retiré est libérée par releaseItem() : si T n'a pas de constructeur par défaut sans
+     * exception, l'élément reste en vie jusqu'à la réutilisation de sa case, ou jusqu'à clear() ou compact().
+     */
+    void remove(const T& t)
+    {
+        //Evidemment, il va falloir compléter cette fonction pour qu'elle retire l'élément du QuadTree
+        if (m_nodes.empty()) {
+            return;
+        }
+        SLimits r = boundsOf(t);
+        // Si on a des enfants, on voit si l'élément peut y être
+        std::uint32_t index = ROOT;
+        std::uint32_t child;
+        while ((child = childContaining(index, r)) != NO_CHILDREN) {
+            index = child;
+        }
+        // Sinon, on le retire de ce nœud localement (les limites sont comparées avant l'élément lui-même)
+        SNode& node = m_nodes[index];
+        std::size_t i = 0;
+        while (i < node.ids.size() && !(node.boundsAt(i) == r && m_items[node.ids[i]] == t)) {
+            ++i;
+        }
+        if (i == node.ids.size()) {
+            return;
+        }
+        releaseItem(node.ids[i]);
+        node.eraseAt(i);
+        m_generation = nextGeneration();
+
+        // Met à jour les compteurs le long du chemin (le même que ci-dessus), en regroupant le plus haut nœud
+        // devenu assez peu peuplé : ses descendants, et donc la suite du chemin, disparaissent
+        index = ROOT;
+        do {
+            --m_nodes[index].count;
+            if (mergeIfSparse(index)) {
+                break;
+            }
+            index = childContaining(index, r);
+        } while (index != NO_CHILDREN);
+    }
+
+    /**
+ * @brief Récupère tous les éléments stockés dans le QuadTree.
+ *
+ * Cette fonction retourne une liste de tous les éléments stockés dans le QuadTree,
+ * y compris ceux stockés dans les enfants.
+ *
+ * @return Une liste de tous les éléments stockés dans le QuadTree.
+ */
+    container getAll() const
+    {
+        container result;
+        getAll(result);
+        return result;
+    }
+
+    /**
+     * @brief Ajoute à la fin de out tous les éléments stockés dans le QuadTree.
+     *
+     * out n'est pas vidé : un même tampon peut servir d'une image à l'autre sans nouvelle allocation.
+     */
+    void getAll(container& out) const
+    {
+        out.reserve(out.size() + size()); // Préalloue l'espace pour optimiser les insertions
+        if (!m_nodes.empty()) {
+            forEachAllIn(ROOT, [&out](const T& t) { out.push_back(t); });
+        }
+    }
+
+    /**
+     * @brief Ajoute à la fin de out un pointeur vers chacun des éléments stockés dans le QuadTree, sans les copier.
+     *
+     * Les pointeurs restent valides jusqu'à la prochaine modification du QuadTree.
+     */
+    void getAll(pointer_container& out) const
+    {
+        out.reserve(out.size() + size());
+        if (!m_nodes.empty()) {
+            forEachAllIn(ROOT, [&out](const T& t) { out.push_back(&t); });
+        }
+    }
+
+    /**
+     * @brief Écrit tous les éléments stockés dans le QuadTree vers l'itérateur de sortie out.
+     *
+     * @return L'itérateur après le dernier élément écrit.
+     */
+    template<std::output_iterator<const T&> O>
+    O getAll(O out) const
+    {
+        if (!m_nodes.empty()) {
+            forEachAllIn(ROOT, [&out](const T& t) { *out++ = t; });
+        }
+        return out;
+    }
+
+    /**
   * @brief Trouve les éléments totalement inclus dans une zone spécifiée.
   *
   * Cette fonction recherche et retourne une liste de tous les éléments stockés dans le QuadTree
@@ -522,30 +2132,47 @@ public:
     container findInscribed(const SLimits& limits) const
     {
         container result;
+        findInscribed(limits, result);
+        return result;
+    }
 
-        // Vérifie si l'objet courant chevauche la zone de recherche
-        if (!overlap(_limits, limits)) {
-            return result; // Aucun chevauchement
+    /**
+     * @brief Ajoute à la fin de out les éléments totalement inclus dans la zone spécifiée.
+     *
+     * out n'est pas vidé : un même tampon peut servir d'une image à l'autre sans nouvelle allocation.
+     */
+    void findInscribed(const SLimits& limits, container& out) const
+    {
+        if (!m_nodes.empty()) {
+            forEachIn<true>(ROOT, limits, [&out](const T& t) { out.push_back(t); }, reserveFor(out));
         }
+    }
 
-        // Parcourt les éléments pour trouver ceux totalement inclus
-        for (const auto& item : m_data) {
-            if (isFullyInside(boundsOf(item), limits)) {
-                result.push_back(item);
-            }
+    /**
+     * @brief Ajoute à la fin de out un pointeur vers chacun des éléments totalement inclus dans la zone spécifiée,
+     *        sans les copier.
+     *
+     * Les pointeurs restent valides jusqu'à la prochaine modification du QuadTree.
+     */
+    void findInscribed(const SLimits& limits, pointer_container& out) const
+    {
+        if (!m_nodes.empty()) {
+            forEachIn<true>(ROOT, limits, [&out](const T& t) { out.push_back(&t); }, reserveFor(out));
         }
+    }
 
-
-        // Explore récursivement les enfants s'ils existent
-        for (const auto& child : m_children) {
-            if (child) {
-                container childResults = child->findInscribed(limits);
-                result.insert(result.end(), childResults.begin(), childResults.end());
-            }
+    /**
+     * @brief Écrit les éléments totalement inclus dans la zone spécifiée vers l'itérateur de sortie out.
+     *
+     * @return L'itérateur après le dernier élément écrit.
+     */
+    template<std::output_iterator<const T&> O>
+    O findInscribed(const SLimits& limits, O out) const
+    {
+        if (!m_nodes.empty()) {
+            forEachIn<true>(ROOT, limits, [&out](const T& t) { *out++ = t; });
         }
-
-
-        return result;
+        return out;
     }
 
     /**
@@ -561,39 +2188,425 @@ public:
     {
         //Evidemment, il va falloir compléter cette fonction pour qu'elle retourne tous les éléments en collision avec la zone spécifiée
         container result;
+        findColliding(limits, result);
+        return result;
+    }
 
-        // Vérifie si l'objet courant chevauche la zone de recherche
-        if (!overlap(_limits, limits)) {
-            return result; // Aucun chevauchement
+    /**
+     * @brief Ajoute à la fin de out les éléments en collision avec la zone spécifiée.
+     *
+     * out n'est pas vidé : un même tampon peut servir d'une image à l'autre sans nouvelle allocation.
+     */
+    void findColliding(const SLimits& limits, container& out) const
+    {
+        if (!m_nodes.empty()) {
+            forEachIn<false>(ROOT, limits, [&out](const T& t) { out.push_back(t); }, reserveFor(out));
         }
+    }
 
-        // Parcourt les éléments de la structure pour trouver ceux qui se chevauchent
-        result.reserve(m_data.size());
-        for (const auto& item : m_data) {
-            if (overlap(boundsOf(item), limits)) {
-                result.push_back(item);
-            }
+    /**
+     * @brief Ajoute à la fin de out un pointeur vers chacun des éléments en collision avec la zone spécifiée,
+     *        sans les copier.
+     *
+     * Les pointeurs restent valides jusqu'à la prochaine modification du QuadTree.
+     */
+    void findColliding(const SLimits& limits, pointer_container& out) const
+    {
+        if (!m_nodes.empty()) {
+            forEachIn<false>(ROOT, limits, [&out](const T& t) { out.push_back(&t); }, reserveFor(out));
+        }
+    }
+
+    /**
+     * @brief Écrit les éléments en collision avec la zone spécifiée vers l'itérateur de sortie out.
+     *
+     * @return L'itérateur après le dernier élément écrit.
+     */
+    template<std::output_iterator<const T&> O>
+    O findColliding(const SLimits& limits, O out) const
+    {
+        if (!m_nodes.empty()) {
+            forEachIn<false>(ROOT, limits, [&out](const T& t) { *out++ = t; });
+        }
+        return out;
+    }
+
+    /**
+     * @brief Trouve au plus maxResults éléments en collision avec la zone spécifiée.
+     *
+     * La recherche s'arrête dès que maxResults éléments sont trouvés ; les enfants les plus proches du centre
+     * de la zone sont visités en premier. Les éléments retournés ne sont pas forcément les plus proches.
+     *
+     * @param limits Les limites de la zone de recherche.
+     * @param maxResults Le nombre maximal d'éléments retournés.
+     * @return Les éléments trouvés.
+     */
+    container findColliding(const SLimits& limits, std::size_t maxResults) const
+    {
+        container result;
+        if (maxResults == 0 || m_nodes.empty()) {
+            return result;
+        }
+        auto collect = [&result, maxResults](const T& t) {
+            result.push_back(t);
+            return result.size() < maxResults;
+        };
+        collidingNearFirst(ROOT, limits, (limits.x1 + limits.x2) * 0.5f, (limits.y1 + limits.y2) * 0.5f, collect);
+        return result;
+    }
+
+    /**
+     * @brief Trouve un élément en collision avec la zone spécifiée, en s'arrêtant au premier trouvé.
+     *
+     * Les enfants les plus proches du centre de la zone sont visités en premier.
+     *
+     * @param limits Les limites de la zone de recherche.
+     * @return Un pointeur vers l'élément trouvé (valide jusqu'à la prochaine modification du QuadTree),
+     *         ou nullptr si aucun élément n'est en collision avec la zone.
+     */
+    const T* firstColliding(const SLimits& limits) const
+    {
+        const T* result = nullptr;
+        if (m_nodes.empty()) {
+            return result;
+        }
+        auto stop = [&result](const T& t) {
+            result = &t;
+            return false;
+        };
+        collidingNearFirst(ROOT, limits, (limits.x1 + limits.x2) * 0.5f, (limits.y1 + limits.y2) * 0.5f, stop);
+        return result;
+    }
+
+    /**
+     * @brief Indique si au moins un élément est en collision avec la zone spécifiée.
+     *
+     * @param limits Les limites de la zone de recherche.
+     * @return true si un élément est en collision avec la zone.
+     */
+    bool anyColliding(const SLimits& limits) const
+    {
+        return firstColliding(limits) != nullptr;
+    }
+
+    /**
+     * @brief Trouve les k éléments les plus proches du point (x, y).
+     *
+     * Parcours « meilleur d'abord » : nœuds et éléments sont rangés dans une file de priorité selon
+     * leur distance au point (distance aux limites élargies pour un nœud, qui minore celle de ses éléments).
+     * Un élément sorti de la file est donc le plus proche des éléments restants, et la recherche s'arrête
+     * dès que k éléments sont trouvés : les nœuds plus lointains ne sont jamais ouverts.
+     *
+     * La distance d'un élément est celle du point à son rectangle (nulle si le point est dedans).
+     *
+     * @param x, y Le point de recherche.
+     * @param k Le nombre maximal d'éléments retournés.
+     * @return Les éléments trouvés, du plus proche au plus lointain.
+     */
+    container findNearest(float x, float y, std::size_t k) const
+    {
+        return findNearest(x, y, k, std::numeric_limits<float>::infinity());
+    }
+
+    /**
+     * @brief Trouve les k éléments les plus proches du point (x, y), à une distance d'au plus maxDistance.
+     *
+     * @param x, y Le point de recherche.
+     * @param k Le nombre maximal d'éléments retournés.
+     * @param maxDistance La distance maximale au point.
+     * @return Les éléments trouvés, du plus proche au plus lointain.
+     */
+    container findNearest(float x, float y, std::size_t k, float maxDistance) const
+    {
+        container result;
+        if (k == 0 || !(maxDistance >= 0.0f) || m_nodes.empty()) {
+            return result;
         }
+        const float maxDistance2 = maxDistance * maxDistance;
+
+        std::priority_queue<SNearestEntry> queue;
+        queue.push({ distance2(m_nodes[ROOT].loose, x, y), ROOT, false });
+        while (!queue.empty() && result.size() < k) {
+            const SNearestEntry entry = queue.top();
+            queue.pop();
+            if (entry.distance2 > maxDistance2) {
+                break;
+            }
+            if (entry.item) {
+                result.push_back(m_items[entry.index]);
+                continue;
+            }
 
-        // Explore les enfants récursivement s'ils existent
-        for (const auto& child : m_children) {
-            if (child) {
-                container childResults = child->findColliding(limits);
-                result.insert(result.end(), childResults.begin(), childResults.end());
+            const SNode& node = m_nodes[entry.index];
+            for (std::size_t i = 0; i < node.ids.size(); ++i) {
+                const float d2 = distance2(node.boundsAt(i), x, y);
+                if (d2 <= maxDistance2) {
+                    queue.push({ d2, node.ids[i], true });
+                }
             }
+            if (node.hasChildren()) {
+                for (std::uint32_t i = 0; i < 4; i++) {
+                    const float d2 = distance2(m_nodes[node.firstChild + i].loose, x, y);
+                    if (d2 <= maxDistance2 && m_nodes[node.firstChild + i].count > 0) {
+                        queue.push({ d2, node.firstChild + i, false });
+                    }
+                }
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Trouve les éléments contenant le point (x, y), bords compris.
+     *
+     * @param x, y Le point de recherche.
+     * @return Les éléments contenant le point.
+     */
+    container findContaining(float x, float y) const
+    {
+        container result;
+        forEachContaining(x, y, [&result](const T& t) { result.push_back(t); });
+        return result;
+    }
+
+    /**
+     * @brief Appelle f pour chaque élément contenant le point (x, y), sans rien allouer.
+     *
+     * Seuls les nœuds dont les limites élargies contiennent le point sont visités.
+     * f reçoit un const T& ; s'il retourne un booléen, false interrompt la recherche.
+     *
+     * @return false si la recherche a été interrompue par f.
+     */
+    template<typename F>
+        requires std::invocable<F&, const T&>
+    bool forEachContaining(float x, float y, F&& f) const
+    {
+        // Un élément contient le point si et seulement s'il est en collision avec le rectangle réduit à ce point
+        return m_nodes.empty() || forEachIn<false>(ROOT, { x, y, x, y }, f);
+    }
+
+    /**
+     * @brief Trouve les éléments touchés par le rayon (ox, oy) + t * (dx, dy), pour t dans [0, maxT].
+     *
+     * Avec maxT = 1, (dx, dy) est le vecteur d'un segment partant de (ox, oy).
+     *
+     * @return Les éléments touchés, par paramètre d'entrée t croissant.
+     */
+    container raycast(float ox, float oy, float dx, float dy, float maxT = std::numeric_limits<float>::infinity()) const
+    {
+        std::vector<std::pair<float, const T*>> hits;
+        const SRay ray = makeRay(ox, oy, dx, dy, maxT);
+        float t;
+        if (!m_nodes.empty() && slabTest(m_nodes[ROOT].loose, ray, t)) {
+            raycastIn(ROOT, ray, [&hits](const T& item, float tEnter) {
+                hits.push_back({ tEnter, &item });
+                });
         }
+        std::stable_sort(hits.begin(), hits.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
 
+        container result;
+        result.reserve(hits.size());
+        for (const auto& hit : hits) {
+            result.push_back(*hit.second);
+        }
         return result;
     }
 
+    /**
+     * @brief Appelle f(item, t) pour chaque élément touché par le rayon (ox, oy) + t * (dx, dy), t dans [0, maxT],
+     *        sans rien allouer.
+     *
+     * Les nœuds sont parcourus d'avant en arrière (par paramètre d'entrée croissant) ; dans un nœud,
+     * les éléments sont visités dans l'ordre de stockage. t est le paramètre d'entrée du rayon dans l'élément.
+     * S'il retourne un booléen, false interrompt le parcours.
+     *
+     * @return false si le parcours a été interrompu par f.
+     */
+    template<typename F>
+        requires std::invocable<F&, const T&, float>
+    bool raycast(float ox, float oy, float dx, float dy, float maxT, F&& f) const
+    {
+        const SRay ray = makeRay(ox, oy, dx, dy, maxT);
+        float t;
+        return m_nodes.empty() || !slabTest(m_nodes[ROOT].loose, ray, t) || raycastIn(ROOT, ray, f);
+    }
+
+    /**
+     * @brief Trouve le premier élément touché par le rayon (ox, oy) + t * (dx, dy), pour t dans [0, maxT].
+     *
+     * Les nœuds où le rayon entre après le meilleur élément trouvé ne sont pas visités.
+     *
+     * @return Un pointeur vers l'élément de plus petit paramètre d'entrée (valide jusqu'à la prochaine modification
+     *         du QuadTree), ou nullptr si aucun élément n'est touché.
+     */
+    const T* raycastFirst(float ox, float oy, float dx, float dy, float maxT = std::numeric_limits<float>::infinity()) const
+    {
+        const SRay ray = makeRay(ox, oy, dx, dy, maxT);
+        float t;
+        if (m_nodes.empty() || !slabTest(m_nodes[ROOT].loose, ray, t)) {
+            return nullptr;
+        }
+        float bestT = std::numeric_limits<float>::infinity();
+        std::uint32_t best = 0;
+        raycastFirstIn(ROOT, ray, bestT, best);
+        return bestT == std::numeric_limits<float>::infinity() ? nullptr : &m_items[best];
+    }
+
+    /**
+     * @brief Compte les éléments en collision avec la zone spécifiée, sans les copier.
+     *
+     * Les sous-arbres entièrement dans la zone sont comptés d'un coup : le coût dépend des nœuds
+     * qui chevauchent le bord de la zone, pas du nombre d'éléments trouvés.
+     *
+     * @param limits Les limites de la zone de recherche.
+     * @return Le nombre d'éléments que retournerait findColliding(limits).
+     */
+    std::size_t countColliding(const SLimits& limits) const
+    {
+        return m_nodes.empty() ? 0 : countIn<false>(ROOT, limits);
+    }
+
+    /**
+     * @brief Compte les éléments entièrement inclus dans la zone spécifiée, sans les copier.
+     *
+     * @param limits Les limites de la zone de recherche.
+     * @return Le nombre d'éléments que retournerait findInscribed(limits).
+     */
+    std::size_t countInscribed(const SLimits& limits) const
+    {
+        return m_nodes.empty() ? 0 : countIn<true>(ROOT, limits);
+    }
+
+    /**
+     * @brief Appelle f pour chaque élément en collision avec la zone spécifiée, sans rien allouer.
+     *
+     * f reçoit un const T& ; s'il retourne un booléen, false interrompt la recherche.
+     *
+     * @param limits Les limites de la zone de recherche.
+     * @param f Le visiteur.
+     * @return false si la recherche a été interrompue par f.
+     */
+    template<typename F>
+        requires std::invocable<F&, const T&>
+    bool forEachColliding(const SLimits& limits, F&& f) const
+    {
+        return m_nodes.empty() || forEachIn<false>(ROOT, limits, f);
+    }
+
+    /**
+     * @brief Appelle f(queryIndex, item) pour chaque élément en collision avec chacune des zones de queries.
+     *
+     * Toutes les requêtes descendent l'arbre ensemble : elles sont réparties entre les enfants à chaque nœud,
+     * si bien que chaque nœud n'est visité qu'une fois et ses éléments ne sont chargés qu'une fois pour toutes
+     * les requêtes qui le touchent. Les appels sont donc regroupés par nœud et non par requête.
+     * S'il retourne un booléen, false interrompt la recherche.
+     *
+     * @param queries Les limites des zones de recherche ; queryIndex est l'indice dans queries.
+     * @param f Le visiteur.
+     * @return false si la recherche a été interrompue par f.
+     */
+    template<typename F>
+        requires std::invocable<F&, std::size_t, const T&>
+    bool findCollidingBatch(std::span<const SLimits> queries, F&& f) const
+    {
+        if (m_nodes.empty()) {
+            return true;
+        }
+        // La pile garde une liste de requêtes (au plus queries.size()) par niveau du chemin en cours, soit au pire
+        // queries.size() * depth() indices : seuls les deux premiers niveaux sont réservés, la suite grandit au besoin
+        std::vector<std::size_t> active;
+        active.reserve(2 * queries.size());
+        for (std::size_t q = 0; q < queries.size(); ++q) {
+            if (overlap(m_nodes[ROOT].loose, queries[q])) {
+                active.push_back(q);
+            }
+        }
+        auto byItem = [&f](const T& t, std::size_t q) { return f(q, t); };
+        return active.empty() || batchIn(ROOT, queries, active, 0, byItem);
+    }
+
+    /**
+     * @brief Appelle f(a, b) une seule fois pour chaque paire d'éléments distincts en collision.
+     *
+     * Les éléments de chaque nœud sont comparés entre eux, aux éléments de ses descendants et à ceux des
+     * sous-arbres voisins dont les limites élargies touchent les siennes. Chaque comparaison entre deux listes
+     * d'éléments se fait par balayage selon x (sweep and prune) : un index trié par nœud est construit au départ,
+     * puis aucune allocation n'a lieu pendant la recherche. S'il retourne un booléen, false interrompt la recherche.
+     *
+     * @param f Le visiteur.
+     * @return false si la recherche a été interrompue par f.
+     */
+    template<typename F>
+        requires std::invocable<F&, const T&, const T&>
+    bool forEachCollidingPair(F&& f) const
+    {
+        if (size() < 2) {
+            return true;
+        }
+        const SSweepIndex sweep = sweepIndex();
+        return pairsIn(sweep, ROOT, f);
+    }
+
+    /**
+     * @brief Recherche en collision avec niveau de détail : les nœuds plus petits que minSize ne sont pas détaillés.
+     *
+     * Un nœud touchant la zone dont la largeur et la hauteur (élargies) sont inférieures à minSize, et qui contient
+     * au moins deux éléments, est transmis à g sous la forme d'un seul SAggregate au lieu de ses éléments.
+     * Les autres éléments en collision avec la zone sont transmis à f. Avec minSize égal à la taille d'un pixel,
+     * le nombre de résultats dépend de la résolution de l'écran et non du nombre d'éléments.
+     * Un agrégat au bord de la zone peut compter des éléments qui ne la touchent pas.
+     * S'ils retournent un booléen, false interrompt la recherche.
+     *
+     * @param limits Les limites de la zone de recherche.
+     * @param minSize La taille en deçà de laquelle un nœud est agrégé.
+     * @param f Le visiteur des éléments.
+     * @param g Le visiteur des agrégats.
+     * @return false si la recherche a été interrompue par f ou g.
+     */
+    template<typename F, typename G>
+        requires std::invocable<F&, const T&> && std::invocable<G&, const SAggregate&>
+    bool forEachCollidingLod(const SLimits& limits, float minSize, F&& f, G&& g) const
+    {
+        return m_nodes.empty() || lodIn(ROOT, limits, minSize, f, g);
+    }
+
+    /**
+     * @brief Recherche en collision avec niveau de détail, dans des conteneurs fournis (voir forEachCollidingLod).
+     *
+     * @param limits Les limites de la zone de recherche.
+     * @param minSize La taille en deçà de laquelle un nœud est agrégé.
+     * @param items Reçoit (à la suite de son contenu) les éléments détaillés.
+     * @param aggregates Reçoit (à la suite de son contenu) les agrégats.
+     */
+    void findCollidingLod(const SLimits& limits, float minSize, container& items, std::vector<SAggregate>& aggregates) const
+    {
+        forEachCollidingLod(limits, minSize,
+            [&items](const T& t) { items.push_back(t); },
+            [&aggregates](const SAggregate& a) { aggregates.push_back(a); });
+    }
+
+    /**
+     * @brief Appelle f pour chaque élément entièrement inclus dans la zone spécifiée, sans rien allouer.
+     *
+     * f reçoit un const T& ; s'il retourne un booléen, false interrompt la recherche.
+     *
+     * @param limits Les limites de la zone de recherche.
+     * @param f Le visiteur.
+     * @return false si la recherche a été interrompue par f.
+     */
+    template<typename F>
+        requires std::invocable<F&, const T&>
+    bool forEachInscribed(const SLimits& limits, F&& f) const
+    {
+        return m_nodes.empty() || forEachIn<true>(ROOT, limits, f);
+    }
+
     /**
      * @brief Itérateur sur tous les éléments.
      */
     iterator begin()
     {
-        // On fabrique un vecteur contenant tout
-        auto data = std::make_shared<container>(getAll());
-        return iterator(data, 0);
+        return iterator(this, iterator::EFilter::all, {});
     }
 
     /**
@@ -601,8 +2614,7 @@ public:
      */
     iterator beginColliding(const SLimits& limits)
     {
-        auto data = std::make_shared<container>(findColliding(limits));
-        return iterator(data, 0);
+        return iterator(this, iterator::EFilter::colliding, limits);
     }
 
     /**
@@ -610,8 +2622,7 @@ public:
      */
     iterator beginInscribed(const SLimits& limits)
     {
-        auto data = std::make_shared<container>(findInscribed(limits));
-        return iterator(data, 0);
+        return iterator(this, iterator::EFilter::inscribed, limits);
     }
 
     /**
@@ -622,4 +2633,4 @@ public:
         return {};
     }
 
-};
\ No newline at end of file
+};
@@ -0,0 +1,177 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include "TQuadTree.h"
+
+/**
+ * @brief Recherche de vue (viewport) mise en cache d'une image à l'autre.
+ *
+ * Garde la fenêtre et les résultats (par pointeurs, sans copie) de la recherche précédente :
+ * - si le QuadTree n'a pas été modifié (voir TQuadTree::generation()) et que la fenêtre est la même,
+ *   le résultat en cache est retourné immédiatement ;
+ * - si la nouvelle fenêtre recouvre largement l'ancienne (petit déplacement ou zoom), seules les bandes
+ *   ajoutées sont interrogées et les éléments sortis de la fenêtre sont retirés du résultat ;
+ * - sinon, la recherche complète est refaite.
+ *
+ * Le cache ne doit pas survivre au QuadTree interrogé. L'ordre des résultats n'est pas celui de findColliding.
+ *
+ * @tparam T Le type des données stockées dans le QuadTree.
+ */
+template <QuadTreeData T>
+class TViewportQuery
+{
+public:
+    using pointer_container = typename TQuadTree<T>::pointer_container;
+
+    /**
+     * @brief Critère de sélection des éléments de la vue.
+     */
+    enum class EMode
+    {
+        colliding,  ///< Éléments en collision avec la fenêtre (findColliding)
+        inscribed   ///< Éléments entièrement inclus dans la fenêtre (findInscribed)
+    };
+
+    /**
+     * @brief Part minimale de la nouvelle fenêtre déjà couverte par l'ancienne pour une mise à jour incrémentale.
+     *
+     * En deçà, les bandes à interroger couvrent presque toute la fenêtre : une recherche complète est plus simple.
+     */
+    static constexpr float MIN_OVERLAP_RATIO = 0.5f;
+
+    explicit TViewportQuery(EMode mode = EMode::colliding)
+        : m_mode(mode)
+    {}
+
+    /**
+     * @brief Retourne les éléments de tree retenus pour la fenêtre, en réutilisant la recherche précédente.
+     *
+     * @param tree Le QuadTree interrogé.
+     * @param window Les limites de la fenêtre.
+     * @return Les pointeurs vers les éléments retenus, valides jusqu'à la prochaine modification de tree
+     *         ou le prochain appel.
+     */
+    const pointer_container& query(const TQuadTree<T>& tree, const SLimits& window)
+    {
+        if (m_tree == &tree && m_generation == tree.generation()) {
+            if (window == m_window) {
+                return m_result;
+            }
+            if (overlapRatio(window) >= MIN_OVERLAP_RATIO) {
+                update(tree, window);
+                m_window = window;
+                return m_result;
+            }
+        }
+
+        m_result.clear();
+        if (m_mode == EMode::colliding) {
+            tree.findColliding(window, m_result);
+        }
+        else {
+            tree.findInscribed(window, m_result);
+        }
+        m_tree = &tree;
+        m_generation = tree.generation();
+        m_window = window;
+        return m_result;
+    }
+
+    /**
+     * @brief Oublie la recherche précédente : le prochain appel à query refera une recherche complète.
+     */
+    void invalidate() noexcept
+    {
+        m_tree = nullptr;
+    }
+
+private:
+    static SLimits boundsOf(const T& t) noexcept
+    {
+        return { t.x1(), t.y1(), t.x2(), t.y2() };
+    }
+
+    static bool overlap(const SLimits& a, const SLimits& b) noexcept
+    {
+        return !(b.x1 > a.x2 || b.x2 < a.x1 || b.y1 > a.y2 || b.y2 < a.y1);
+    }
+
+    static bool isInside(const SLimits& a, const SLimits& b) noexcept
+    {
+        return a.x1 >= b.x1 && a.y1 >= b.y1 && a.x2 <= b.x2 && a.y2 <= b.y2;
+    }
+
+    /**
+     * @brief Indique si un élément de limites b est retenu pour la fenêtre window.
+     */
+    bool accepts(const SLimits& b, const SLimits& window) const noexcept
+    {
+        return m_mode == EMode::colliding ? overlap(b, window) : isInside(b, window);
+    }
+
+    /**
+     * @brief Part de la fenêtre window couverte par la fenêtre précédente.
+     */
+    float overlapRatio(const SLimits& window) const noexcept
+    {
+        const float w = std::min(window.x2, m_window.x2) - std::max(window.x1, m_window.x1);
+        const float h = std::min(window.y2, m_window.y2) - std::max(window.y1, m_window.y1);
+        const float area = (window.x2 - window.x1) * (window.y2 - window.y1);
+        if (w < 0.0f || h < 0.0f || !(area > 0.0f)) {
+            return 0.0f;
+        }
+        return w * h / area;
+    }
+
+    /**
+     * @brief Met à jour le résultat de la fenêtre précédente pour la fenêtre window (qui la recouvre en partie).
+     *
+     * Un élément nouvellement retenu touche forcément window sans être retenu pour l'ancienne fenêtre :
+     * il touche donc la partie de window hors de l'ancienne fenêtre, découpée en au plus 4 bandes
+     * (gauche et droite sur toute la hauteur, haut et bas entre les deux).
+     */
+    void update(const TQuadTree<T>& tree, const SLimits& window)
+    {
+        std::erase_if(m_result, [this, &window](const T* t) { return !accepts(boundsOf(*t), window); });
+
+        SLimits strips[4];
+        std::size_t n = 0;
+        if (window.x1 < m_window.x1) {
+            strips[n++] = { window.x1, window.y1, m_window.x1, window.y2 };
+        }
+        if (window.x2 > m_window.x2) {
+            strips[n++] = { m_window.x2, window.y1, window.x2, window.y2 };
+        }
+        const float x1 = std::max(window.x1, m_window.x1);
+        const float x2 = std::min(window.x2, m_window.x2);
+        if (window.y1 < m_window.y1) {
+            strips[n++] = { x1, window.y1, x2, m_window.y1 };
+        }
+        if (window.y2 > m_window.y2) {
+            strips[n++] = { x1, m_window.y2, x2, window.y2 };
+        }
+
+        for (std::size_t s = 0; s < n; ++s) {
+            tree.forEachColliding(strips[s], [&](const T& t) {
+                const SLimits b = boundsOf(t);
+                // Déjà dans le résultat, ou déjà trouvé dans une bande précédente (les bandes se touchent par leurs bords)
+                if (!accepts(b, window) || accepts(b, m_window)) {
+                    return;
+                }
+                for (std::size_t p = 0; p < s; ++p) {
+                    if (overlap(b, strips[p])) {
+                        return;
+                    }
+                }
+                m_result.push_back(&t);
+            });
+        }
+    }
+
+    EMode m_mode;                           ///< Critère de sélection
+    const TQuadTree<T>* m_tree = nullptr;   ///< QuadTree de la recherche précédente (nullptr : aucune)
+    std::uint64_t m_generation = 0;         ///< Génération de m_tree lors de la recherche précédente
+    SLimits m_window{};                     ///< Fenêtre de la recherche précédente
+    pointer_container m_result;             ///< Résultat de la recherche précédente
+};
@@ -0,0 +1,210 @@
+#include <iostream>
+#include <chrono>
+#include <functional>
+#include <list>
+
+#include "catch_amalgamated.hpp"
+#include "QuadTree.h"
+#include "TLinearQuadTree.h"
+
+//Même zone de recherche que dans tests.cpp
+static const SLimits subDataLimits = { 0.42f, 0.43f, 0.72f, 0.73f };
+
+//Défini dans tests.cpp
+void readDataSet(size_t& depth, size_t& datasetSize, std::function<void(float x1, float y1, float x2, float y2)> callback);
+
+/**
+ * @brief Compare les différents paramètres de subdivision du QuadTree.
+ *
+ * Pour chaque configuration, mesure le temps d'insertion du fichier de données, le temps de recherche
+ * dans subDataLimits ainsi que la profondeur et le nombre de nœuds de l'arbre obtenu.
+ *
+ * @note Ce test est caché et doit être exécuté explicitement par la ligne de commande
+ */
+TEST_CASE("TQuadTree.6-Split policies benchmark", "[.policies]") {
+  //Lit un fichier de données de test
+  std::list<Rectangle> rectsAll;
+  size_t depth;
+  size_t datasetSize;
+  readDataSet(depth, datasetSize, [&rectsAll](float x1, float y1, float x2, float y2) {
+    rectsAll.push_back(Rectangle(x1, y1, x2, y2));
+    });
+
+  struct {
+    const char* name;
+    SQuadTreeConfig config;
+  } policies[] = {
+    { "eagerFit, capacity 1", {} },
+    { "countThreshold, capacity 8", { 8, 64, ESplitTrigger::countThreshold } },
+    { "countThreshold, capacity 32", { 32, 64, ESplitTrigger::countThreshold } },
+    { "countThreshold, capacity 128", { 128, 64, ESplitTrigger::countThreshold } },
+    { "areaRatio 1/16, capacity 8", { 8, 64, ESplitTrigger::areaRatio, 0.0625f } },
+    { "areaRatio 1/64, capacity 32", { 32, 64, ESplitTrigger::areaRatio, 0.015625f } },
+    { "eagerFit, capacity 1, maxDepth 8", { 1, 8, ESplitTrigger::eagerFit } },
+    { "countThreshold, capacity 8, loose x2", { 8, 64, ESplitTrigger::countThreshold, 0.0625f, 2.0f } },
+    { "countThreshold, capacity 32, loose x2", { 32, 64, ESplitTrigger::countThreshold, 0.0625f, 2.0f } },
+  };
+
+  for (const auto& policy : policies)
+  {
+    std::chrono::high_resolution_clock::time_point start, end;
+
+    start = std::chrono::high_resolution_clock::now();
+    QuadTree qt({ 0.0f, 0.0f, 1.0f, 1.0f }, policy.config);
+    for (const auto& rect : rectsAll)
+    {
+      qt.insert(rect);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    auto insertionTime_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+
+    start = std::chrono::high_resolution_clock::now();
+    auto inscribed = qt.findInscribed(subDataLimits);
+    end = std::chrono::high_resolution_clock::now();
+    auto findingTime_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+    start = std::chrono::high_resolution_clock::now();
+    auto colliding = qt.findColliding(subDataLimits);
+    end = std::chrono::high_resolution_clock::now();
+    auto collidingTime_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+    REQUIRE(qt.size() == datasetSize);
+
+    //Rapporte les résultats
+    SUCCEED(policy.name << "\n"
+      "Insertion time: " << insertionTime_ms.count() << " ms\n"
+      "Finding time (container): " << findingTime_us.count() << " us (" << inscribed.size() << " found)\n"
+      "Colliding time (container): " << collidingTime_us.count() << " us (" << colliding.size() << " found)\n"
+      "Depth: " << qt.depth() << ", nodes: " << qt.nodeCount() << "\n");
+  }
+}
+
+/**
+ * @brief Compare TQuadTree (insertions successives ou chargement en bloc) et le QuadTree linéaire
+ * TLinearQuadTree sur le fichier de données.
+ *
+ * @note Ce test est caché et doit être exécuté explicitement par la ligne de commande
+ */
+TEST_CASE("TQuadTree.9-Linear QuadTree benchmark", "[.backends]") {
+  //Lit un fichier de données de test
+  std::list<Rectangle> rectsAll;
+  size_t depth;
+  size_t datasetSize;
+  readDataSet(depth, datasetSize, [&rectsAll](float x1, float y1, float x2, float y2) {
+    rectsAll.push_back(Rectangle(x1, y1, x2, y2));
+    });
+
+  auto benchmark = [&rectsAll, datasetSize](auto&& fill, const char* name) {
+    std::chrono::high_resolution_clock::time_point start, end;
+
+    start = std::chrono::high_resolution_clock::now();
+    auto qt = fill();
+    end = std::chrono::high_resolution_clock::now();
+    auto insertionTime_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+
+    start = std::chrono::high_resolution_clock::now();
+    auto inscribed = qt.findInscribed(subDataLimits);
+    end = std::chrono::high_resolution_clock::now();
+    auto findingTime_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+    start = std::chrono::high_resolution_clock::now();
+    auto colliding = qt.findColliding(subDataLimits);
+    end = std::chrono::high_resolution_clock::now();
+    auto collidingTime_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+    REQUIRE(qt.size() == datasetSize);
+
+    //Rapporte les résultats
+    SUCCEED(name << "\n"
+      "Insertion time: " << insertionTime_ms.count() << " ms\n"
+      "Finding time (container): " << findingTime_us.count() << " us (" << inscribed.size() << " found)\n"
+      "Colliding time (container): " << collidingTime_us.count() << " us (" << colliding.size() << " found)\n");
+  };
+
+  benchmark([&rectsAll] {
+    QuadTree qt;
+    for (const auto& rect : rectsAll)
+      qt.insert(rect);
+    return qt;
+    }, "TQuadTree");
+  benchmark([&rectsAll, depth] {
+    QuadTree qt({ 0.0f, 0.0f, 1.0f, 1.0f }, rectsAll.begin(), rectsAll.end());
+    REQUIRE(qt.depth() == depth);
+    return qt;
+    }, "TQuadTree (bulk load)");
+  benchmark([&rectsAll] {
+    TLinearQuadTree<Rectangle> qt;
+    for (const auto& rect : rectsAll)
+      qt.insert(rect);
+    //La première lecture trie les éléments insérés : elle fait partie de la construction
+    REQUIRE(qt.depth() > 0);
+    return qt;
+    }, "TLinearQuadTree");
+}
+
+/**
+ * @brief Compare les jeux d'instructions des filtres de CBoxFilter (scalaire, SSE, AVX2, AVX-512) disponibles
+ * sur cette machine, sur le fichier de données.
+ *
+ * Pour chaque jeu, mesure l'insertion (les subdivisions filtrent les éléments par paquets) puis les recherches
+ * dans subDataLimits, répétées pour dépasser la résolution de l'horloge.
+ *
+ * @note Ce test est caché et doit être exécuté explicitement par la ligne de commande
+ */
+TEST_CASE("TQuadTree.30-SIMD kernels benchmark", "[.simd]") {
+  //Lit un fichier de données de test
+  std::list<Rectangle> rectsAll;
+  size_t depth;
+  size_t datasetSize;
+  readDataSet(depth, datasetSize, [&rectsAll](float x1, float y1, float x2, float y2) {
+    rectsAll.push_back(Rectangle(x1, y1, x2, y2));
+    });
+
+  const char* names[] = { "scalar", "SSE", "AVX2", "AVX-512" };
+  const int repeats = 100;
+  const EInstructionSet original = CBoxFilter::instructionSet();
+  const auto supported = static_cast<int>(CBoxFilter::supportedInstructionSet());
+  for (int isa = 0; isa <= supported; isa++)
+  {
+    CBoxFilter::setInstructionSet(static_cast<EInstructionSet>(isa));
+    std::chrono::high_resolution_clock::time_point start, end;
+
+    start = std::chrono::high_resolution_clock::now();
+    QuadTree qt({ 0.0f, 0.0f, 1.0f, 1.0f }, { 8, 64, ESplitTrigger::countThreshold });
+    for (const auto& rect : rectsAll)
+    {
+      qt.insert(rect);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    auto insertionTime_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+
+    QuadTree::pointer_container found;
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < repeats; i++)
+    {
+      found.clear();
+      qt.findInscribed(subDataLimits, found);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    auto findingTime_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start) / repeats;
+    size_t inscribed = found.size();
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < repeats; i++)
+    {
+      found.clear();
+      qt.findColliding(subDataLimits, found);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    auto collidingTime_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start) / repeats;
+
+    REQUIRE(qt.size() == datasetSize);
+
+    //Rapporte les résultats
+    SUCCEED(names[isa] << "\n"
+      "Insertion time: " << insertionTime_ms.count() << " ms\n"
+      "Finding time (pointers): " << findingTime_us.count() << " us (" << inscribed << " found)\n"
+      "Colliding time (pointers): " << collidingTime_us.count() << " us (" << found.size() << " found)\n");
+  }
+  CBoxFilter::setInstructionSet(original);
+}
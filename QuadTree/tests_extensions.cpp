@@ -0,0 +1,1127 @@
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <random>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "catch_amalgamated.hpp"
+#include "QuadTree.h"
+#include "TLinearQuadTree.h"
+#include "TViewportQuery.h"
+
+/**
+ * @brief Génère n rectangles aléatoires de taille au plus maxSize dans la surface 1x1.
+ */
+static std::vector<Rectangle> randomRectangles(size_t n, float maxSize, unsigned seed)
+{
+  std::default_random_engine dre(seed);
+  std::uniform_real_distribution<float> urd(0.0f, 1.0f);
+  std::vector<Rectangle> rects;
+  rects.reserve(n);
+  for (size_t i = 0; i < n; i++)
+  {
+    float width = urd(dre) * maxSize;
+    float height = urd(dre) * maxSize;
+    float x1 = urd(dre) * (1.0f - width);
+    float y1 = urd(dre) * (1.0f - height);
+    rects.push_back(Rectangle(x1, y1, x1 + width, y1 + height));
+  }
+  return rects;
+}
+
+/**
+ * @brief Trie des rectangles, pour comparer des résultats dont l'ordre n'est pas spécifié.
+ */
+static std::vector<Rectangle> sorted(std::vector<Rectangle> v)
+{
+  std::sort(v.begin(), v.end());
+  return v;
+}
+
+/**
+ * @brief Configurations parcourues par la plupart des tests : celle par défaut (eagerFit, capacité 1)
+ * et un loose QuadTree (countThreshold, capacité 8, élargissement x2).
+ */
+static Catch::Generators::GeneratorWrapper<SQuadTreeConfig> testConfigs()
+{
+  return Catch::Generators::values({ SQuadTreeConfig{}, SQuadTreeConfig{ 8, 64, ESplitTrigger::countThreshold, 0.0625f, 2.0f } });
+}
+
+/**
+ * @brief Teste la cohérence des compteurs de sous-arbre avec le contenu réel du QuadTree.
+ */
+TEST_CASE("TQuadTree.7-QuadTree subtree counts", "[counts]") {
+  SQuadTreeConfig config = GENERATE(testConfigs(), values({
+    SQuadTreeConfig{ 8, 64, ESplitTrigger::countThreshold },
+    SQuadTreeConfig{ 4, 64, ESplitTrigger::areaRatio } }));
+  QuadTree qt({ 0.0f, 0.0f, 1.0f, 1.0f }, config);
+  auto rects = randomRectangles(5000, 0.1f, 7);
+  for (const auto& rect : rects)
+    qt.insert(rect);
+  REQUIRE(qt.size() == 5000);
+
+  //Retire les trois quarts des rectangles, puis un rectangle absent
+  std::shuffle(rects.begin(), rects.end(), std::default_random_engine(3));
+  for (size_t i = 0; i < 3750; i++)
+    qt.remove(rects[i]);
+  qt.remove(Rectangle(0.1f, 0.1f, 0.2f, 0.2f));
+  REQUIRE(qt.size() == 1250);
+  REQUIRE(qt.getAll().size() == 1250);
+  REQUIRE(qt.empty() == false);
+
+  for (size_t i = 3750; i < rects.size(); i++)
+    qt.remove(rects[i]);
+  REQUIRE(qt.size() == 0);
+  REQUIRE(qt.empty() == true);
+}
+
+/**
+ * @brief Teste que le QuadTree linéaire retourne les mêmes résultats que TQuadTree.
+ */
+TEST_CASE("TQuadTree.8-Linear QuadTree matches TQuadTree", "[linear]") {
+  QuadTree qt;
+  TLinearQuadTree<Rectangle> lqt;
+  REQUIRE(lqt.empty());
+  REQUIRE(lqt.depth() == 1);
+  REQUIRE_THROWS_AS(lqt.insert(Rectangle(-0.5f, 0.0f, 1.0f, 1.0f)), std::domain_error);
+
+  auto rects = randomRectangles(5000, 0.1f, 11);
+  for (const auto& rect : rects)
+  {
+    qt.insert(rect);
+    lqt.insert(rect);
+  }
+  REQUIRE(lqt.size() == qt.size());
+  //Une copie prise avant toute lecture contient les insertions en attente
+  TLinearQuadTree<Rectangle> copy(lqt);
+  REQUIRE(sorted(copy.getAll()) == sorted(qt.getAll()));
+
+  REQUIRE(sorted(lqt.getAll()) == sorted(qt.getAll()));
+  REQUIRE(std::distance(lqt.begin(), lqt.end()) == 5000);
+
+  auto queries = randomRectangles(50, 0.5f, 13);
+  queries.push_back(Rectangle(0.0f, 0.0f, 1.0f, 1.0f));
+  for (const auto& q : queries)
+  {
+    SLimits limits{ q.x1(), q.y1(), q.x2(), q.y2() };
+    REQUIRE(sorted(lqt.findColliding(limits)) == sorted(qt.findColliding(limits)));
+    REQUIRE(sorted(lqt.findInscribed(limits)) == sorted(qt.findInscribed(limits)));
+    REQUIRE(sorted(std::vector<Rectangle>(lqt.beginColliding(limits), lqt.end())) == sorted(qt.findColliding(limits)));
+  }
+
+  //Retire la moitié des rectangles des deux arbres
+  for (size_t i = 0; i < rects.size(); i += 2)
+  {
+    qt.remove(rects[i]);
+    lqt.remove(rects[i]);
+  }
+  REQUIRE(lqt.size() == 2500);
+  SLimits limits{ 0.25f, 0.25f, 0.6f, 0.7f };
+  REQUIRE(sorted(lqt.findColliding(limits)) == sorted(qt.findColliding(limits)));
+  REQUIRE(sorted(lqt.getAll()) == sorted(qt.getAll()));
+
+  //Retraits et insertions mêlés, y compris le retrait d'une insertion encore en attente
+  lqt.insert(rects[2]);
+  lqt.remove(rects[2]);
+  lqt.remove(rects[2]);
+  lqt.remove(rects[1]);
+  lqt.remove(rects[1]);
+  lqt.insert(rects[0]);
+  lqt.remove(rects[3]);
+  qt.remove(rects[1]);
+  qt.insert(rects[0]);
+  qt.remove(rects[3]);
+  REQUIRE(lqt.size() == qt.size());
+  REQUIRE(sorted(lqt.getAll()) == sorted(qt.getAll()));
+
+  //Chaque lecture voit la modification qui la précède, comme sur TQuadTree
+  for (size_t i = 0; i < 200; ++i)
+  {
+    qt.insert(rects[i]);
+    lqt.insert(rects[i]);
+    qt.remove(rects[i + 1]);
+    lqt.remove(rects[i + 1]);
+    REQUIRE(sorted(lqt.findColliding(limits)) == sorted(qt.findColliding(limits)));
+  }
+  REQUIRE(lqt.size() == qt.size());
+  REQUIRE(sorted(lqt.getAll()) == sorted(qt.getAll()));
+
+  lqt.clear();
+  REQUIRE(lqt.empty());
+  REQUIRE(lqt.begin() == lqt.end());
+}
+
+/**
+ * @brief Teste que le chargement en bloc donne le même arbre que des insertions successives.
+ */
+TEST_CASE("TQuadTree.10-QuadTree bulk load", "[bulk]") {
+  SQuadTreeConfig config = GENERATE(testConfigs(), values({
+    SQuadTreeConfig{ 8, 64, ESplitTrigger::countThreshold },
+    SQuadTreeConfig{ 4, 64, ESplitTrigger::areaRatio },
+    SQuadTreeConfig{ 1, 5, ESplitTrigger::eagerFit } }));
+  auto rects = randomRectangles(5000, 0.1f, 17);
+
+  QuadTree incremental({ 0.0f, 0.0f, 1.0f, 1.0f }, config);
+  for (const auto& rect : rects)
+    incremental.insert(rect);
+  QuadTree bulk({ 0.0f, 0.0f, 1.0f, 1.0f }, rects.begin(), rects.end(), config);
+
+  REQUIRE(bulk.size() == incremental.size());
+  REQUIRE(bulk.depth() == incremental.depth());
+  REQUIRE(bulk.nodeCount() == incremental.nodeCount());
+  REQUIRE(bulk.getAll() == incremental.getAll());
+
+  //build() remplace le contenu ; un élément hors limites laisse l'arbre intact
+  bulk.build(std::vector<Rectangle>(rects.begin(), rects.begin() + 100));
+  REQUIRE(bulk.size() == 100);
+  std::vector<Rectangle> invalid{ Rectangle(0.1f, 0.1f, 0.2f, 0.2f), Rectangle(-0.5f, 0.0f, 1.0f, 1.0f) };
+  REQUIRE_THROWS_AS(bulk.build(invalid), std::domain_error);
+  REQUIRE(bulk.size() == 100);
+  bulk.build(std::vector<Rectangle>{});
+  REQUIRE(bulk.empty());
+  REQUIRE(bulk.depth() == 1);
+}
+
+/**
+ * @brief Teste que le QuadTree relâché (loose) retourne les mêmes résultats qu'un QuadTree classique.
+ */
+TEST_CASE("TQuadTree.11-Loose QuadTree", "[loose]") {
+  REQUIRE_THROWS_AS(QuadTree({ 0.0f, 0.0f, 1.0f, 1.0f }, SQuadTreeConfig{ 8, 64, ESplitTrigger::countThreshold, 0.0625f, 0.5f }),
+    std::invalid_argument);
+
+  float looseness = GENERATE(1.5f, 2.0f);
+  QuadTree qt;
+  QuadTree loose({ 0.0f, 0.0f, 1.0f, 1.0f }, SQuadTreeConfig{ 8, 64, ESplitTrigger::countThreshold, 0.0625f, looseness });
+  auto rects = randomRectangles(5000, 0.1f, 19);
+  for (const auto& rect : rects)
+  {
+    qt.insert(rect);
+    loose.insert(rect);
+  }
+
+  auto queries = randomRectangles(50, 0.5f, 23);
+  queries.push_back(Rectangle(0.0f, 0.0f, 1.0f, 1.0f));
+  queries.push_back(Rectangle(0.5f, 0.5f, 0.5f, 0.5f));
+  for (const auto& q : queries)
+  {
+    SLimits limits{ q.x1(), q.y1(), q.x2(), q.y2() };
+    REQUIRE(sorted(loose.findColliding(limits)) == sorted(qt.findColliding(limits)));
+    REQUIRE(sorted(loose.findInscribed(limits)) == sorted(qt.findInscribed(limits)));
+  }
+
+  for (size_t i = 0; i < rects.size(); i += 2)
+    loose.remove(rects[i]);
+  REQUIRE(loose.size() == 2500);
+  REQUIRE(loose.findColliding({ 0.0f, 0.0f, 1.0f, 1.0f }).size() == 2500);
+}
+
+/**
+ * @brief Teste la réutilisation des cases de la réserve d'éléments et l'indépendance des copies.
+ */
+TEST_CASE("TQuadTree.12-QuadTree item slab", "[slab]") {
+  QuadTree qt({ 0.0f, 0.0f, 1.0f, 1.0f }, SQuadTreeConfig{ 8, 64, ESplitTrigger::countThreshold });
+  auto rects = randomRectangles(2000, 0.1f, 29);
+  for (const auto& rect : rects)
+    qt.insert(rect);
+
+  QuadTree copy(qt);
+  for (size_t i = 0; i < 1000; i++)
+    copy.remove(rects[i]);
+  REQUIRE(qt.size() == 2000);
+  REQUIRE(sorted(qt.getAll()) == sorted(rects));
+
+  //Les insertions suivantes réutilisent les cases libérées
+  auto others = randomRectangles(1000, 0.1f, 31);
+  for (const auto& rect : others)
+    copy.insert(rect);
+  std::vector<Rectangle> expected(rects.begin() + 1000, rects.end());
+  expected.insert(expected.end(), others.begin(), others.end());
+  REQUIRE(copy.size() == 2000);
+  REQUIRE(sorted(copy.getAll()) == sorted(expected));
+  SLimits limits{ 0.2f, 0.3f, 0.6f, 0.5f };
+  auto colliding = copy.findColliding(limits);
+  REQUIRE(std::all_of(colliding.begin(), colliding.end(), [&limits](const Rectangle& r) {
+    return !(r.x1() > limits.x2 || r.x2() < limits.x1 || r.y1() > limits.y2 || r.y2() < limits.y1);
+    }));
+
+  //Les ajouts dans une réserve copiée ne déplacent pas les éléments déjà rangés
+  TItemSlab<int> slab;
+  for (int i = 0; i < 10; i++)
+    slab.push_back(i);
+  TItemSlab<int> slabCopy(slab);
+  const int* first = &slabCopy[0];
+  for (int i = 0; i < 1000; i++)
+    slabCopy.push_back(i);
+  REQUIRE(&slabCopy[0] == first);
+  REQUIRE(slabCopy.size() == 1010);
+  REQUIRE(slabCopy[9] == 9);
+
+  //Un élément retiré ou refusé par emplace est détruit, sans attendre la réutilisation de sa case
+  struct SOwner {
+    float x = 0.0f, y = 0.0f;
+    std::shared_ptr<int> resource;
+    float x1() const { return x; }
+    float y1() const { return y; }
+    float x2() const { return x; }
+    float y2() const { return y; }
+    bool operator==(const SOwner& other) const { return x == other.x && y == other.y; }
+  };
+  auto resource = std::make_shared<int>(0);
+  TQuadTree<SOwner> owners;
+  owners.insert(SOwner{ 0.25f, 0.25f, resource });
+  owners.insert(SOwner{ 0.75f, 0.75f, resource });
+  REQUIRE(resource.use_count() == 3);
+  owners.remove(SOwner{ 0.25f, 0.25f, nullptr });
+  REQUIRE(resource.use_count() == 2);
+  REQUIRE_THROWS_AS(owners.emplace(SOwner{ 1.5f, 0.5f, resource }), std::domain_error);
+  REQUIRE(resource.use_count() == 2);
+}
+
+/**
+ * @brief Teste le déplacement, l'échange et l'insertion par déplacement ou construction sur place.
+ */
+TEST_CASE("TQuadTree.13-QuadTree move semantics", "[move]") {
+  static_assert(std::is_nothrow_move_constructible_v<QuadTree>);
+  static_assert(std::is_nothrow_move_assignable_v<QuadTree>);
+  static_assert(std::is_nothrow_swappable_v<QuadTree>);
+
+  QuadTree qt({ 0.0f, 0.0f, 2.0f, 2.0f });
+  auto rects = randomRectangles(1000, 0.1f, 37);
+  for (const auto& rect : rects)
+    qt.insert(Rectangle(rect));
+  qt.emplace(1.5f, 1.5f, 1.75f, 1.75f);
+  REQUIRE_THROWS_AS(qt.emplace(1.5f, 1.5f, 2.5f, 1.75f), std::domain_error);
+  REQUIRE(qt.size() == 1001);
+  const auto all = qt.getAll();
+
+  //L'arbre d'origine reste utilisable, vide et avec les mêmes limites
+  QuadTree moved(std::move(qt));
+  REQUIRE(moved.getAll() == all);
+  REQUIRE(qt.empty());
+  REQUIRE(qt.limits() == SLimits{ 0.0f, 0.0f, 2.0f, 2.0f });
+  REQUIRE(qt.depth() == 1);
+  REQUIRE(qt.nodeCount() == 1);
+  REQUIRE(qt.getAll().empty());
+  REQUIRE(qt.findColliding({ 0.0f, 0.0f, 2.0f, 2.0f }).empty());
+  REQUIRE(qt.countInscribed({ 0.0f, 0.0f, 2.0f, 2.0f }) == 0);
+  REQUIRE(qt.firstColliding({ 0.0f, 0.0f, 2.0f, 2.0f }) == nullptr);
+  REQUIRE(qt.findNearest(1.0f, 1.0f, 3).empty());
+  REQUIRE(qt.raycastFirst(0.0f, 0.0f, 1.0f, 1.0f) == nullptr);
+  REQUIRE(qt.begin() == qt.end());
+  qt.remove(all.front());
+  qt.compact();
+  qt.insert(Rectangle(1.0f, 1.0f, 1.5f, 1.5f));
+  REQUIRE(qt.size() == 1);
+  REQUIRE(qt.findColliding({ 0.0f, 0.0f, 2.0f, 2.0f }).size() == 1);
+
+  //emplace recrée aussi la racine d'un arbre déplacé
+  QuadTree emplaced(std::move(qt));
+  qt.emplace(0.25f, 0.25f, 0.5f, 0.5f);
+  REQUIRE(qt.getAll() == QuadTree::container{ Rectangle(0.25f, 0.25f, 0.5f, 0.5f) });
+  qt = std::move(emplaced);
+  REQUIRE(qt.size() == 1);
+
+  //Construction sans exception : emplace construit directement dans la case libérée par remove
+  struct SPoint {
+    float x, y;
+    SPoint(float px, float py) noexcept : x(px), y(py) {}
+    float x1() const { return x; }
+    float y1() const { return y; }
+    float x2() const { return x; }
+    float y2() const { return y; }
+    bool operator==(const SPoint&) const = default;
+  };
+  TQuadTree<SPoint> points;
+  points.emplace(0.25f, 0.25f);
+  points.emplace(0.75f, 0.75f);
+  const SPoint* slot = points.firstColliding({ 0.25f, 0.25f, 0.25f, 0.25f });
+  points.remove(SPoint(0.25f, 0.25f));
+  points.emplace(0.5f, 0.5f);
+  REQUIRE(points.firstColliding({ 0.5f, 0.5f, 0.5f, 0.5f }) == slot);
+  REQUIRE(*slot == SPoint(0.5f, 0.5f));
+  REQUIRE(points.size() == 2);
+
+  QuadTree other;
+  other = std::move(moved);
+  REQUIRE(other.getAll() == all);
+  REQUIRE(other.limits() == SLimits{ 0.0f, 0.0f, 2.0f, 2.0f });
+
+  swap(other, qt);
+  REQUIRE(qt.getAll() == all);
+  REQUIRE(other.size() == 1);
+}
+
+/**
+ * @brief Teste les recherches par visiteur et leur interruption.
+ */
+TEST_CASE("TQuadTree.14-QuadTree visitors", "[visitors]") {
+  QuadTree qt({ 0.0f, 0.0f, 1.0f, 1.0f }, SQuadTreeConfig{ 8, 64, ESplitTrigger::countThreshold });
+  for (const auto& rect : randomRectangles(5000, 0.1f, 41))
+    qt.insert(rect);
+
+  SLimits limits{ 0.2f, 0.1f, 0.7f, 0.6f };
+  std::vector<Rectangle> colliding;
+  REQUIRE(qt.forEachColliding(limits, [&colliding](const Rectangle& r) { colliding.push_back(r); }));
+  REQUIRE(colliding == qt.findColliding(limits));
+  std::vector<Rectangle> inscribed;
+  REQUIRE(qt.forEachInscribed(limits, [&inscribed](const Rectangle& r) { inscribed.push_back(r); return true; }));
+  REQUIRE(inscribed == qt.findInscribed(limits));
+
+  //Le visiteur arrête la recherche en retournant false
+  size_t visited = 0;
+  REQUIRE_FALSE(qt.forEachColliding(limits, [&visited](const Rectangle&) { return ++visited < 10; }));
+  REQUIRE(visited == 10);
+  REQUIRE(qt.forEachColliding({ 2.0f, 2.0f, 3.0f, 3.0f }, [](const Rectangle&) { return false; }));
+}
+
+/**
+ * @brief Teste les recherches écrivant dans un tampon ou un itérateur de sortie fourni par l'appelant.
+ */
+TEST_CASE("TQuadTree.15-QuadTree output buffers", "[buffers]") {
+  QuadTree qt;
+  for (const auto& rect : randomRectangles(3000, 0.1f, 43))
+    qt.insert(rect);
+  SLimits limits{ 0.3f, 0.3f, 0.8f, 0.55f };
+
+  //Les résultats sont ajoutés à la fin du tampon, sans le vider
+  std::vector<Rectangle> buffer{ Rectangle(0.0f, 0.0f, 0.1f, 0.1f) };
+  qt.findColliding(limits, buffer);
+  auto colliding = qt.findColliding(limits);
+  REQUIRE(buffer.size() == colliding.size() + 1);
+  REQUIRE(std::equal(colliding.begin(), colliding.end(), buffer.begin() + 1));
+
+  buffer.clear();
+  qt.findInscribed(limits, buffer);
+  REQUIRE(buffer == qt.findInscribed(limits));
+  buffer.clear();
+  qt.getAll(buffer);
+  REQUIRE(buffer == qt.getAll());
+
+  std::vector<Rectangle> viaIterator;
+  qt.findColliding(limits, std::back_inserter(viaIterator));
+  REQUIRE(viaIterator == colliding);
+  std::vector<Rectangle> array(qt.size());
+  REQUIRE(qt.getAll(array.begin()) == array.end());
+  REQUIRE(array == qt.getAll());
+  auto inscribed = qt.findInscribed(limits);
+  REQUIRE(qt.findInscribed(limits, array.begin()) == array.begin() + inscribed.size());
+}
+
+/**
+ * @brief Teste que les itérateurs paresseux parcourent les mêmes éléments, dans le même ordre, que les recherches.
+ */
+TEST_CASE("TQuadTree.16-QuadTree lazy iterators", "[iterators]") {
+  SQuadTreeConfig config = GENERATE(testConfigs(), values({ SQuadTreeConfig{ 100, 64, ESplitTrigger::countThreshold } }));
+  QuadTree qt({ 0.0f, 0.0f, 1.0f, 1.0f }, config);
+  REQUIRE(qt.begin() == qt.end());
+  REQUIRE(qt.beginColliding({ 0.0f, 0.0f, 1.0f, 1.0f }) == qt.end());
+
+  for (const auto& rect : randomRectangles(4000, 0.1f, 47))
+    qt.insert(rect);
+  REQUIRE(std::vector<Rectangle>(qt.begin(), qt.end()) == qt.getAll());
+
+  auto queries = randomRectangles(20, 0.5f, 53);
+  queries.push_back(Rectangle(2.0f, 2.0f, 3.0f, 3.0f));
+  for (const auto& q : queries)
+  {
+    SLimits limits{ q.x1(), q.y1(), q.x2(), q.y2() };
+    REQUIRE(std::vector<Rectangle>(qt.beginColliding(limits), qt.end()) == qt.findColliding(limits));
+    REQUIRE(std::vector<Rectangle>(qt.beginInscribed(limits), qt.end()) == qt.findInscribed(limits));
+  }
+
+  //Une copie de l'itérateur reprend le parcours au même point
+  auto it = qt.begin();
+  ++it;
+  auto copy = it++;
+  REQUIRE(copy != it);
+  REQUIRE(++copy == it);
+  REQUIRE(*copy == *it);
+}
+
+/**
+ * @brief Teste les recherches couvrant des sous-arbres entiers, comparées à une recherche exhaustive.
+ */
+TEST_CASE("TQuadTree.17-QuadTree wide queries", "[wide]") {
+  SQuadTreeConfig config = GENERATE(testConfigs());
+  QuadTree qt({ 0.0f, 0.0f, 1.0f, 1.0f }, config);
+  auto rects = randomRectangles(4000, 0.05f, 59);
+  for (const auto& rect : rects)
+    qt.insert(rect);
+
+  SLimits queries[] = {
+    { -1.0f, -1.0f, 2.0f, 2.0f },
+    { 0.0f, 0.0f, 1.0f, 1.0f },
+    { 0.0f, 0.0f, 0.5f, 1.0f },
+    { 0.05f, 0.1f, 0.95f, 0.8f },
+  };
+  for (const auto& limits : queries)
+  {
+    std::vector<Rectangle> colliding, inscribed;
+    for (const auto& r : rects)
+    {
+      if (!(r.x1() > limits.x2 || r.x2() < limits.x1 || r.y1() > limits.y2 || r.y2() < limits.y1))
+        colliding.push_back(r);
+      if (r.x1() >= limits.x1 && r.y1() >= limits.y1 && r.x2() <= limits.x2 && r.y2() <= limits.y2)
+        inscribed.push_back(r);
+    }
+    REQUIRE(sorted(qt.findColliding(limits)) == sorted(colliding));
+    REQUIRE(sorted(qt.findInscribed(limits)) == sorted(inscribed));
+    REQUIRE(sorted(std::vector<Rectangle>(qt.beginColliding(limits), qt.end())) == sorted(colliding));
+    REQUIRE(sorted(std::vector<Rectangle>(qt.beginInscribed(limits), qt.end())) == sorted(inscribed));
+    REQUIRE(qt.countColliding(limits) == colliding.size());
+    REQUIRE(qt.countInscribed(limits) == inscribed.size());
+  }
+}
+
+/**
+ * @brief Teste les recherches par comptage.
+ */
+TEST_CASE("TQuadTree.18-QuadTree counting queries", "[count]") {
+  QuadTree qt({ 0.0f, 0.0f, 1.0f, 1.0f }, SQuadTreeConfig{ 8, 64, ESplitTrigger::countThreshold });
+  REQUIRE(qt.countColliding({ 0.0f, 0.0f, 1.0f, 1.0f }) == 0);
+  auto rects = randomRectangles(5000, 0.1f, 61);
+  for (const auto& rect : rects)
+    qt.insert(rect);
+
+  for (const auto& q : randomRectangles(50, 0.6f, 67))
+  {
+    SLimits limits{ q.x1(), q.y1(), q.x2(), q.y2() };
+    REQUIRE(qt.countColliding(limits) == qt.findColliding(limits).size());
+    REQUIRE(qt.countInscribed(limits) == qt.findInscribed(limits).size());
+  }
+  REQUIRE(qt.countInscribed({ 0.0f, 0.0f, 1.0f, 1.0f }) == 5000);
+
+  for (size_t i = 0; i < 2500; i++)
+    qt.remove(rects[i]);
+  REQUIRE(qt.countColliding({ -1.0f, -1.0f, 2.0f, 2.0f }) == 2500);
+  SLimits limits{ 0.1f, 0.2f, 0.6f, 0.9f };
+  REQUIRE(qt.countColliding(limits) == qt.findColliding(limits).size());
+}
+
+/**
+ * @brief Teste la recherche des plus proches voisins contre une recherche exhaustive.
+ */
+TEST_CASE("TQuadTree.19-QuadTree nearest neighbours", "[nearest]") {
+  SQuadTreeConfig config = GENERATE(testConfigs());
+  QuadTree qt({ 0.0f, 0.0f, 1.0f, 1.0f }, config);
+  REQUIRE(qt.findNearest(0.5f, 0.5f, 3).empty());
+  auto rects = randomRectangles(3000, 0.05f, 71);
+  for (const auto& rect : rects)
+    qt.insert(rect);
+
+  auto distance = [](const Rectangle& r, float x, float y) {
+    float dx = std::max({ r.x1() - x, 0.0f, x - r.x2() });
+    float dy = std::max({ r.y1() - y, 0.0f, y - r.y2() });
+    return dx * dx + dy * dy;
+  };
+  std::default_random_engine dre(73);
+  std::uniform_real_distribution<float> urd(-0.2f, 1.2f);
+  for (int q = 0; q < 30; q++)
+  {
+    float x = urd(dre), y = urd(dre);
+    std::vector<float> expected;
+    for (const auto& r : rects)
+      expected.push_back(distance(r, x, y));
+    std::sort(expected.begin(), expected.end());
+
+    auto nearest = qt.findNearest(x, y, 10);
+    REQUIRE(nearest.size() == 10);
+    for (size_t i = 0; i < nearest.size(); i++)
+      REQUIRE(distance(nearest[i], x, y) == expected[i]);
+
+    //Avec une distance maximale, seuls les éléments assez proches sont retournés
+    float maxDistance = 0.05f;
+    auto within = qt.findNearest(x, y, 1000, maxDistance);
+    size_t count = std::count_if(expected.begin(), expected.end(), [maxDistance](float d) { return d <= maxDistance * maxDistance; });
+    REQUIRE(within.size() == std::min<size_t>(count, 1000));
+  }
+  REQUIRE(qt.findNearest(0.5f, 0.5f, 0).empty());
+  REQUIRE(qt.findNearest(0.5f, 0.5f, 5000).size() == 3000);
+}
+
+/**
+ * @brief Teste les requêtes par point et par rayon contre une recherche exhaustive.
+ */
+TEST_CASE("TQuadTree.20-QuadTree point and ray queries", "[ray]") {
+  SQuadTreeConfig config = GENERATE(testConfigs());
+  QuadTree qt({ 0.0f, 0.0f, 1.0f, 1.0f }, config);
+  auto rects = randomRectangles(3000, 0.05f, 79);
+  for (const auto& rect : rects)
+    qt.insert(rect);
+
+  //Paramètre d'entrée du rayon dans r, ou -1 s'il ne le touche pas
+  auto entry = [](const Rectangle& r, float ox, float oy, float dx, float dy, float maxT) {
+    float tMin = 0.0f, tMax = maxT;
+    float o[2] = { ox, oy }, d[2] = { dx, dy }, lo[2] = { r.x1(), r.y1() }, hi[2] = { r.x2(), r.y2() };
+    for (int a = 0; a < 2; a++)
+    {
+      if (d[a] == 0.0f)
+      {
+        if (o[a] < lo[a] || o[a] > hi[a])
+          return -1.0f;
+        continue;
+      }
+      float t1 = (lo[a] - o[a]) * (1.0f / d[a]), t2 = (hi[a] - o[a]) * (1.0f / d[a]);
+      tMin = std::max(tMin, std::min(t1, t2));
+      tMax = std::min(tMax, std::max(t1, t2));
+    }
+    return tMin <= tMax ? tMin : -1.0f;
+  };
+  auto key = [](const Rectangle& r) { return std::make_pair(r.x1(), r.y1()); };
+
+  std::default_random_engine dre(83);
+  std::uniform_real_distribution<float> urd(-0.2f, 1.2f);
+  for (int q = 0; q < 40; q++)
+  {
+    float x = urd(dre), y = urd(dre);
+    std::vector<std::pair<float, float>> expected, found;
+    for (const auto& r : rects)
+      if (r.x1() <= x && x <= r.x2() && r.y1() <= y && y <= r.y2())
+        expected.push_back(key(r));
+    for (const auto& r : qt.findContaining(x, y))
+      found.push_back(key(r));
+    std::sort(expected.begin(), expected.end());
+    std::sort(found.begin(), found.end());
+    REQUIRE(found == expected);
+
+    //Rayons quelconques, segments (maxT = 1) et rayons parallèles aux axes
+    float dx = urd(dre) - 0.5f, dy = urd(dre) - 0.5f;
+    if (q % 4 == 1)
+      dx = 0.0f;
+    if (q % 4 == 2)
+      dy = 0.0f;
+    float maxT = q % 2 == 0 ? std::numeric_limits<float>::infinity() : 1.0f;
+
+    std::vector<float> expectedT;
+    for (const auto& r : rects)
+      if (float t = entry(r, x, y, dx, dy, maxT); t >= 0.0f)
+        expectedT.push_back(t);
+    std::sort(expectedT.begin(), expectedT.end());
+
+    auto hits = qt.raycast(x, y, dx, dy, maxT);
+    REQUIRE(hits.size() == expectedT.size());
+    for (size_t i = 0; i < hits.size(); i++)
+      REQUIRE(entry(hits[i], x, y, dx, dy, maxT) == expectedT[i]);
+
+    size_t visited = 0;
+    REQUIRE(qt.raycast(x, y, dx, dy, maxT, [&](const Rectangle& r, float t) { REQUIRE(t == entry(r, x, y, dx, dy, maxT)); visited++; }));
+    REQUIRE(visited == expectedT.size());
+
+    const Rectangle* first = qt.raycastFirst(x, y, dx, dy, maxT);
+    if (expectedT.empty())
+      REQUIRE(first == nullptr);
+    else
+    {
+      REQUIRE(first != nullptr);
+      REQUIRE(entry(*first, x, y, dx, dy, maxT) == expectedT.front());
+    }
+  }
+
+  //Arrêt au premier élément touché
+  size_t visited = 0;
+  REQUIRE_FALSE(qt.raycast(-0.1f, 0.5f, 1.0f, 0.0f, 2.0f, [&](const Rectangle&, float) { visited++; return false; }));
+  REQUIRE(visited == 1);
+}
+
+/**
+ * @brief Teste les requêtes groupées contre des requêtes individuelles.
+ */
+TEST_CASE("TQuadTree.21-QuadTree batched queries", "[batch]") {
+  SQuadTreeConfig config = GENERATE(testConfigs());
+  QuadTree qt({ 0.0f, 0.0f, 1.0f, 1.0f }, config);
+  auto rects = randomRectangles(3000, 0.05f, 89);
+  for (const auto& rect : rects)
+    qt.insert(rect);
+
+  //Petites fenêtres, grandes fenêtres couvrant des nœuds entiers, et fenêtres hors du QuadTree
+  std::vector<SLimits> queries;
+  for (const auto& r : randomRectangles(200, 0.1f, 97))
+    queries.push_back({ r.x1(), r.y1(), r.x2(), r.y2() });
+  queries.push_back({ 0.0f, 0.0f, 1.0f, 1.0f });
+  queries.push_back({ 0.1f, 0.2f, 0.7f, 0.9f });
+  queries.push_back({ 2.0f, 2.0f, 3.0f, 3.0f });
+
+  auto key = [](const Rectangle& r) { return std::make_pair(r.x1(), r.y1()); };
+  std::vector<std::vector<std::pair<float, float>>> found(queries.size());
+  REQUIRE(qt.findCollidingBatch(queries, [&](size_t q, const Rectangle& r) { found[q].push_back(key(r)); }));
+  for (size_t q = 0; q < queries.size(); q++)
+  {
+    std::vector<std::pair<float, float>> expected;
+    for (const auto& r : qt.findColliding(queries[q]))
+      expected.push_back(key(r));
+    std::sort(expected.begin(), expected.end());
+    std::sort(found[q].begin(), found[q].end());
+    REQUIRE(found[q] == expected);
+  }
+
+  REQUIRE(qt.findCollidingBatch(std::span<const SLimits>(), [](size_t, const Rectangle&) { FAIL(); }));
+  size_t visited = 0;
+  REQUIRE_FALSE(qt.findCollidingBatch(queries, [&](size_t, const Rectangle&) { return ++visited < 5; }));
+  REQUIRE(visited == 5);
+}
+
+/**
+ * @brief Teste l'énumération des paires en collision contre une recherche exhaustive.
+ */
+TEST_CASE("TQuadTree.22-QuadTree colliding pairs", "[pairs]") {
+  SQuadTreeConfig config = GENERATE(testConfigs());
+  QuadTree qt({ 0.0f, 0.0f, 1.0f, 1.0f }, config);
+  REQUIRE(qt.forEachCollidingPair([](const Rectangle&, const Rectangle&) { FAIL(); }));
+
+  auto rects = randomRectangles(2000, 0.05f, 101);
+  //Éléments qui se touchent exactement sur les frontières des nœuds
+  rects.push_back(Rectangle(0.4f, 0.4f, 0.5f, 0.5f));
+  rects.push_back(Rectangle(0.5f, 0.5f, 0.6f, 0.6f));
+  rects.push_back(Rectangle(0.25f, 0.1f, 0.26f, 0.2f));
+  rects.push_back(Rectangle(0.24f, 0.1f, 0.25f, 0.2f));
+  for (const auto& rect : rects)
+    qt.insert(rect);
+
+  using Key = std::pair<float, float>;
+  auto key = [](const Rectangle& r) { return Key(r.x1(), r.y1()); };
+  auto ordered = [](Key a, Key b) { return a < b ? std::make_pair(a, b) : std::make_pair(b, a); };
+  std::vector<std::pair<Key, Key>> expected, found;
+  for (size_t i = 0; i < rects.size(); i++)
+    for (size_t j = i + 1; j < rects.size(); j++)
+      if (rects[i].x1() <= rects[j].x2() && rects[j].x1() <= rects[i].x2() && rects[i].y1() <= rects[j].y2() && rects[j].y1() <= rects[i].y2())
+        expected.push_back(ordered(key(rects[i]), key(rects[j])));
+  REQUIRE(qt.forEachCollidingPair([&](const Rectangle& a, const Rectangle& b) { found.push_back(ordered(key(a), key(b))); }));
+  std::sort(expected.begin(), expected.end());
+  std::sort(found.begin(), found.end());
+  REQUIRE(found.size() == expected.size());
+  REQUIRE(found == expected);
+
+  size_t visited = 0;
+  REQUIRE_FALSE(qt.forEachCollidingPair([&](const Rectangle&, const Rectangle&) { return ++visited < 3; }));
+  REQUIRE(visited == 3);
+}
+
+/**
+ * @brief Teste la jointure spatiale de deux QuadTree contre une recherche exhaustive.
+ */
+TEST_CASE("TQuadTree.23-QuadTree spatial join", "[join]") {
+  SQuadTreeConfig config = GENERATE(testConfigs());
+  //Deux QuadTree dont les limites et la configuration diffèrent
+  QuadTree staticTree({ 0.0f, 0.0f, 1.0f, 1.0f }, config);
+  QuadTree dynamicTree({ 0.25f, 0.25f, 1.25f, 1.25f });
+  REQUIRE(spatialJoin(staticTree, dynamicTree, [](const Rectangle&, const Rectangle&) { FAIL(); }));
+
+  auto statics = randomRectangles(1500, 0.05f, 103);
+  auto dynamics = randomRectangles(1500, 0.05f, 107);
+  for (auto& rect : dynamics)
+    rect = Rectangle(rect.x1() + 0.25f, rect.y1() + 0.25f, rect.x2() + 0.25f, rect.y2() + 0.25f);
+  for (const auto& rect : statics)
+    staticTree.insert(rect);
+  REQUIRE(spatialJoin(staticTree, dynamicTree, [](const Rectangle&, const Rectangle&) { FAIL(); }));
+  for (const auto& rect : dynamics)
+    dynamicTree.insert(rect);
+
+  using Key = std::pair<float, float>;
+  auto key = [](const Rectangle& r) { return Key(r.x1(), r.y1()); };
+  std::vector<std::pair<Key, Key>> expected, found;
+  for (const auto& a : statics)
+    for (const auto& b : dynamics)
+      if (a.x1() <= b.x2() && b.x1() <= a.x2() && a.y1() <= b.y2() && b.y1() <= a.y2())
+        expected.push_back({ key(a), key(b) });
+  REQUIRE(spatialJoin(staticTree, dynamicTree, [&](const Rectangle& a, const Rectangle& b) { found.push_back({ key(a), key(b) }); }));
+  std::sort(expected.begin(), expected.end());
+  std::sort(found.begin(), found.end());
+  REQUIRE(!expected.empty());
+  REQUIRE(found == expected);
+
+  size_t visited = 0;
+  REQUIRE_FALSE(spatialJoin(staticTree, dynamicTree, [&](const Rectangle&, const Rectangle&) { return ++visited < 4; }));
+  REQUIRE(visited == 4);
+}
+
+/**
+ * @brief Teste la recherche avec niveau de détail.
+ */
+TEST_CASE("TQuadTree.24-QuadTree level of detail", "[lod]") {
+  SQuadTreeConfig config = GENERATE(testConfigs());
+  QuadTree qt({ 0.0f, 0.0f, 1.0f, 1.0f }, config);
+  auto rects = randomRectangles(5000, 0.002f, 109);
+  for (const auto& rect : rects)
+    qt.insert(rect);
+
+  SLimits view{ 0.1f, 0.1f, 0.8f, 0.9f };
+  auto colliding = qt.findColliding(view);
+
+  //Une taille minimale nulle détaille tout
+  QuadTree::container items;
+  std::vector<QuadTree::SAggregate> aggregates;
+  qt.findCollidingLod(view, 0.0f, items, aggregates);
+  REQUIRE(aggregates.empty());
+  REQUIRE(items.size() == colliding.size());
+
+  for (float minSize : { 0.1f, 0.3f })
+  {
+    items.clear();
+    aggregates.clear();
+    qt.findCollidingLod(view, minSize, items, aggregates);
+    REQUIRE(!aggregates.empty());
+    //Les agrégats couvrent au moins tous les éléments non détaillés, et sont plus petits que minSize
+    size_t aggregated = 0;
+    for (const auto& a : aggregates)
+    {
+      REQUIRE(a.count > 1);
+      REQUIRE(a.limits.x2 - a.limits.x1 < minSize);
+      REQUIRE(a.representative != nullptr);
+      REQUIRE(a.limits.x1 <= a.representative->x1());
+      REQUIRE(a.representative->x2() <= a.limits.x2);
+      aggregated += a.count;
+    }
+    REQUIRE(items.size() + aggregated >= colliding.size());
+    REQUIRE(items.size() + aggregates.size() < colliding.size());
+    for (const auto& item : items)
+      REQUIRE(std::find(colliding.begin(), colliding.end(), item) != colliding.end());
+  }
+
+  size_t visited = 0;
+  REQUIRE_FALSE(qt.forEachCollidingLod(view, 0.05f, [&](const Rectangle&) { return ++visited < 2; }, [&](const QuadTree::SAggregate&) { return ++visited < 2; }));
+  REQUIRE(visited == 2);
+}
+
+/**
+ * @brief Teste les résultats par pointeurs, sans copie des éléments.
+ */
+TEST_CASE("TQuadTree.25-QuadTree pointer results", "[pointers]") {
+  QuadTree qt;
+  auto rects = randomRectangles(2000, 0.05f, 113);
+  for (const auto& rect : rects)
+    qt.insert(rect);
+
+  auto same = [](const QuadTree::container& copies, const QuadTree::pointer_container& pointers) {
+    if (copies.size() != pointers.size())
+      return false;
+    for (size_t i = 0; i < copies.size(); i++)
+      if (!(copies[i] == *pointers[i]))
+        return false;
+    return true;
+  };
+  SLimits view{ 0.2f, 0.1f, 0.7f, 0.6f };
+  QuadTree::pointer_container pointers;
+  qt.getAll(pointers);
+  REQUIRE(same(qt.getAll(), pointers));
+  //Les pointeurs désignent les éléments stockés : deux parcours donnent les mêmes adresses
+  QuadTree::pointer_container again;
+  qt.getAll(again);
+  REQUIRE(again == pointers);
+
+  pointers.clear();
+  qt.findColliding(view, pointers);
+  REQUIRE(same(qt.findColliding(view), pointers));
+  pointers.clear();
+  qt.findInscribed(view, pointers);
+  REQUIRE(same(qt.findInscribed(view), pointers));
+  //Ajout à la suite du contenu existant
+  size_t inscribed = pointers.size();
+  qt.findColliding(view, pointers);
+  REQUIRE(pointers.size() == inscribed + qt.countColliding(view));
+}
+
+/**
+ * @brief Teste les recherches qui s'arrêtent aux premiers éléments trouvés.
+ */
+TEST_CASE("TQuadTree.26-QuadTree early terminating queries", "[first]") {
+  SQuadTreeConfig config = GENERATE(testConfigs());
+  QuadTree qt({ 0.0f, 0.0f, 1.0f, 1.0f }, config);
+  REQUIRE_FALSE(qt.anyColliding({ 0.0f, 0.0f, 1.0f, 1.0f }));
+  REQUIRE(qt.firstColliding({ 0.0f, 0.0f, 1.0f, 1.0f }) == nullptr);
+
+  auto rects = randomRectangles(3000, 0.01f, 127);
+  for (const auto& rect : rects)
+    qt.insert(rect);
+
+  std::default_random_engine dre(131);
+  std::uniform_real_distribution<float> urd(-0.1f, 1.0f);
+  std::uniform_real_distribution<float> size(0.0f, 0.2f);
+  for (int q = 0; q < 100; q++)
+  {
+    float x = urd(dre), y = urd(dre);
+    SLimits limits{ x, y, x + size(dre), y + size(dre) };
+    auto colliding = qt.findColliding(limits);
+    REQUIRE(qt.anyColliding(limits) == !colliding.empty());
+    const Rectangle* first = qt.firstColliding(limits);
+    REQUIRE((first != nullptr) == !colliding.empty());
+    if (first)
+      REQUIRE(std::find(colliding.begin(), colliding.end(), *first) != colliding.end());
+
+    for (size_t maxResults : { 0, 1, 5, 100000 })
+    {
+      auto some = qt.findColliding(limits, maxResults);
+      REQUIRE(some.size() == std::min(maxResults, colliding.size()));
+      for (const auto& item : some)
+        REQUIRE(std::find(colliding.begin(), colliding.end(), item) != colliding.end());
+    }
+  }
+}
+
+/**
+ * @brief Teste la recherche de vue en cache contre des recherches complètes.
+ */
+TEST_CASE("TQuadTree.27-QuadTree viewport cache", "[viewport]") {
+  using ViewportQuery = TViewportQuery<Rectangle>;
+  auto mode = GENERATE(ViewportQuery::EMode::colliding, ViewportQuery::EMode::inscribed);
+  QuadTree qt;
+  auto rects = randomRectangles(3000, 0.05f, 137);
+  for (const auto& rect : rects)
+    qt.insert(rect);
+
+  ViewportQuery view(mode);
+  std::default_random_engine dre(139);
+  std::uniform_real_distribution<float> step(-0.03f, 0.03f);
+  std::uniform_real_distribution<float> jump(0.0f, 0.6f);
+  SLimits window{ 0.3f, 0.3f, 0.6f, 0.7f };
+  for (int frame = 0; frame < 200; frame++)
+  {
+    //Petits déplacements et zooms, sauts occasionnels, fenêtre immobile et modifications du QuadTree
+    if (frame % 50 == 49)
+    {
+      float x = jump(dre), y = jump(dre);
+      window = { x, y, x + 0.3f, y + 0.3f };
+    }
+    else if (frame % 7 == 3)
+      qt.remove(rects[frame]);
+    else if (frame % 5 != 0)
+      window = { window.x1 + step(dre), window.y1 + step(dre), window.x2 + step(dre), window.y2 + step(dre) };
+
+    const auto& cached = view.query(qt, window);
+    std::vector<Rectangle> found;
+    for (const Rectangle* r : cached)
+      found.push_back(*r);
+    auto expected = mode == ViewportQuery::EMode::colliding ? qt.findColliding(window) : qt.findInscribed(window);
+    REQUIRE(sorted(found) == sorted(expected));
+  }
+
+  //Une modification du QuadTree change sa génération
+  auto generation = qt.generation();
+  qt.insert(Rectangle(0.4f, 0.4f, 0.41f, 0.41f));
+  REQUIRE(qt.generation() != generation);
+  generation = qt.generation();
+  QuadTree other;
+  qt = other;
+  REQUIRE(qt.generation() != generation);
+
+  //Une copie, ou un QuadTree recréé à la même adresse, ne reprend jamais une génération déjà vue
+  QuadTree copy(qt);
+  REQUIRE(copy.generation() != qt.generation());
+  const SLimits all{ 0.0f, 0.0f, 1.0f, 1.0f };
+  std::optional<QuadTree> recreated(std::in_place);
+  recreated->insert(Rectangle(0.1f, 0.1f, 0.2f, 0.2f));
+  ViewportQuery reused(mode);
+  REQUIRE(reused.query(*recreated, all).size() == 1);
+  recreated.emplace();
+  recreated->insert(Rectangle(0.5f, 0.5f, 0.6f, 0.6f));
+  const auto& fresh = reused.query(*recreated, all);
+  REQUIRE(fresh.size() == 1);
+  REQUIRE(*fresh.front() == Rectangle(0.5f, 0.5f, 0.6f, 0.6f));
+}
+
+/**
+ * @brief Teste le regroupement des sous-arbres lors des suppressions, et le compactage.
+ */
+TEST_CASE("TQuadTree.28-QuadTree merge on remove and compact", "[merge]") {
+  SECTION("Branches vides élaguées par défaut") {
+    QuadTree qt;
+    auto rects = randomRectangles(2000, 0.05f, 149);
+    for (const auto& rect : rects)
+      qt.insert(rect);
+    REQUIRE(qt.depth() > 1);
+    for (const auto& rect : rects)
+      qt.remove(rect);
+    REQUIRE(qt.empty());
+    REQUIRE(qt.depth() == 1);
+    REQUIRE(qt.nodeCount() == 1);
+  }
+
+  SECTION("Regroupement sous un seuil") {
+    SQuadTreeConfig config{ 8, 64, ESplitTrigger::countThreshold, 0.0625f, 1.0f, 8 };
+    QuadTree qt({ 0.0f, 0.0f, 1.0f, 1.0f }, config);
+    auto rects = randomRectangles(3000, 0.05f, 151);
+    for (const auto& rect : rects)
+      qt.insert(rect);
+    size_t nodes = qt.nodeCount();
+
+    std::shuffle(rects.begin(), rects.end(), std::default_random_engine(157));
+    for (size_t i = 0; i < 2500; i++)
+      qt.remove(rects[i]);
+    REQUIRE(qt.size() == 500);
+    REQUIRE(qt.nodeCount() < nodes);
+
+    auto check = [&qt](const std::vector<Rectangle>& present) {
+      REQUIRE(qt.size() == present.size());
+      std::default_random_engine dre(163);
+      std::uniform_real_distribution<float> urd(0.0f, 0.8f);
+      for (int q = 0; q < 20; q++)
+      {
+        float x = urd(dre), y = urd(dre);
+        SLimits limits{ x, y, x + 0.2f, y + 0.2f };
+        size_t expected = std::count_if(present.begin(), present.end(), [&limits](const Rectangle& r) {
+          return r.x1() <= limits.x2 && limits.x1 <= r.x2() && r.y1() <= limits.y2 && limits.y1 <= r.y2();
+          });
+        REQUIRE(qt.findColliding(limits).size() == expected);
+        REQUIRE(qt.countColliding(limits) == expected);
+      }
+    };
+    std::vector<Rectangle> present(rects.begin() + 2500, rects.end());
+    check(present);
+
+    //Le compactage ne change pas le contenu, mais invalide les pointeurs
+    auto generation = qt.generation();
+    nodes = qt.nodeCount();
+    qt.compact();
+    REQUIRE(qt.generation() != generation);
+    REQUIRE(qt.nodeCount() <= nodes);
+    check(present);
+
+    //Les groupes libérés sont réutilisés par les insertions suivantes
+    for (size_t i = 0; i < 2500; i++)
+      qt.insert(rects[i]);
+    check(rects);
+    for (const auto& rect : rects)
+      qt.remove(rect);
+    REQUIRE(qt.empty());
+    REQUIRE(qt.nodeCount() == 1);
+  }
+}
+
+/**
+ * @brief Vérifie que chaque noyau vectoriel disponible donne les mêmes masques que le noyau scalaire,
+ * pour tous les nombres de rectangles de 0 à CBoxFilter::BATCH (paquets incomplets compris) et des rectangles
+ * touchant la zone de recherche par un bord.
+ */
+TEST_CASE("TQuadTree.29-SIMD kernels match scalar kernel", "[kernels]") {
+  //Rétablit le jeu d'instructions d'origine, même si une vérification échoue
+  struct SRestore {
+    EInstructionSet isa = CBoxFilter::instructionSet();
+    ~SRestore() { CBoxFilter::setInstructionSet(isa); }
+  } restore;
+
+  //Coordonnées sur une grille grossière : beaucoup de rectangles ont un bord commun avec la zone de recherche
+  const float grid[] = { 0.0f, 0.25f, 0.5f, 0.75f, 1.0f };
+  std::default_random_engine dre(167);
+  std::uniform_int_distribution<int> uid(0, 4);
+  auto rects = randomRectangles(2 * CBoxFilter::BATCH, 0.5f, 173);
+  for (size_t i = 0; i < rects.size(); i += 2)
+  {
+    float x1 = grid[uid(dre)], y1 = grid[uid(dre)];
+    float x2 = grid[uid(dre)], y2 = grid[uid(dre)];
+    rects[i] = Rectangle(std::min(x1, x2), std::min(y1, y2), std::max(x1, x2), std::max(y1, y2));
+  }
+  const SLimits windows[] = {
+    { 0.25f, 0.25f, 0.75f, 0.75f },
+    { 0.0f, 0.0f, 1.0f, 1.0f },
+    { 0.5f, 0.5f, 0.5f, 0.5f },
+    { 0.1f, 0.3f, 0.6f, 0.45f },
+  };
+
+  const auto supported = static_cast<int>(CBoxFilter::supportedInstructionSet());
+  for (size_t first : { size_t(0), CBoundsArray::LANE_WIDTH })
+  {
+    for (size_t n = 0; n <= CBoxFilter::BATCH; n++)
+    {
+      CBoundsArray bounds;
+      for (size_t i = 0; i < first + n; i++)
+        bounds.push_back(rects[i].x1(), rects[i].y1(), rects[i].x2(), rects[i].y2());
+
+      for (const SLimits& w : windows)
+      {
+        CBoxFilter::setInstructionSet(EInstructionSet::scalar);
+        const auto overlap = CBoxFilter::overlapMask(bounds, first, n, w.x1, w.y1, w.x2, w.y2);
+        const auto inside = CBoxFilter::insideMask(bounds, first, n, w.x1, w.y1, w.x2, w.y2);
+        std::uint64_t expectedOverlap = 0, expectedInside = 0;
+        for (size_t i = 0; i < n; i++)
+        {
+          const Rectangle& r = rects[first + i];
+          if (r.x1() <= w.x2 && w.x1 <= r.x2() && r.y1() <= w.y2 && w.y1 <= r.y2())
+            expectedOverlap |= std::uint64_t(1) << i;
+          if (r.x1() >= w.x1 && r.y1() >= w.y1 && r.x2() <= w.x2 && r.y2() <= w.y2)
+            expectedInside |= std::uint64_t(1) << i;
+        }
+        REQUIRE(overlap == expectedOverlap);
+        REQUIRE(inside == expectedInside);
+
+        for (int isa = 0; isa <= supported; isa++)
+        {
+          CAPTURE(isa, first, n);
+          CBoxFilter::setInstructionSet(static_cast<EInstructionSet>(isa));
+          REQUIRE(CBoxFilter::instructionSet() == static_cast<EInstructionSet>(isa));
+          REQUIRE(CBoxFilter::overlapMask(bounds, first, n, w.x1, w.y1, w.x2, w.y2) == overlap);
+          REQUIRE(CBoxFilter::insideMask(bounds, first, n, w.x1, w.y1, w.x2, w.y2) == inside);
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief Teste l'effet de chaque paramètre de subdivision et le refus des configurations invalides.
+ */
+TEST_CASE("TQuadTree.31-QuadTree split configuration", "[config]") {
+  const SLimits unit{ 0.0f, 0.0f, 1.0f, 1.0f };
+  auto rects = randomRectangles(2000, 0.01f, 179);
+
+  SECTION("maxDepth limite la profondeur") {
+    for (size_t maxDepth : { 1, 3, 6 })
+    {
+      for (ESplitTrigger trigger : { ESplitTrigger::eagerFit, ESplitTrigger::countThreshold })
+      {
+        QuadTree qt(unit, SQuadTreeConfig{ 1, maxDepth, trigger });
+        for (const auto& rect : rects)
+          qt.insert(rect);
+        REQUIRE(qt.size() == rects.size());
+        REQUIRE(qt.depth() == maxDepth);
+      }
+    }
+  }
+
+  SECTION("countThreshold ne subdivise pas sous la capacité") {
+    QuadTree qt(unit, SQuadTreeConfig{ 16, 64, ESplitTrigger::countThreshold });
+    for (size_t i = 0; i < 16; i++)
+      qt.insert(rects[i]);
+    REQUIRE(qt.nodeCount() == 1);
+    qt.insert(rects[16]);
+    REQUIRE(qt.nodeCount() > 1);
+
+    //eagerFit subdivise dès le premier élément qui tient dans un enfant, quelle que soit la capacité
+    QuadTree eager(unit, SQuadTreeConfig{ 16, 64, ESplitTrigger::eagerFit });
+    eager.insert(rects[0]);
+    REQUIRE(eager.nodeCount() > 1);
+  }
+
+  SECTION("areaRatio ne subdivise que pour les petits éléments") {
+    SQuadTreeConfig config{ 16, 64, ESplitTrigger::areaRatio, 0.0625f };
+    //Tient dans l'enfant NO, mais d'aire 0.16 > 0.0625 : pas de subdivision
+    const Rectangle large(0.05f, 0.05f, 0.45f, 0.45f);
+    //Aire 0.0169 <= 0.0625 : subdivision (mais 0.0169 > 0.0625 * 0.25 : pas de seconde subdivision dans l'enfant SE)
+    const Rectangle small(0.6f, 0.6f, 0.73f, 0.73f);
+
+    QuadTree qt(unit, config);
+    qt.insert(large);
+    REQUIRE(qt.nodeCount() == 1);
+    qt.insert(small);
+    REQUIRE(qt.nodeCount() == 5);
+
+    config.areaRatio = 0.25f;
+    QuadTree lenient(unit, config);
+    lenient.insert(large);
+    REQUIRE(lenient.nodeCount() == 5);
+  }
+
+  SECTION("Configurations invalides") {
+    auto make = [&unit](const SQuadTreeConfig& config) { return QuadTree(unit, config); };
+    REQUIRE_THROWS_AS(make({ 0, 64, ESplitTrigger::countThreshold }), std::invalid_argument);
+    REQUIRE_THROWS_AS(make({ 8, 0, ESplitTrigger::countThreshold }), std::invalid_argument);
+    for (float areaRatio : { 0.0f, -0.5f, 1.5f, std::numeric_limits<float>::quiet_NaN() })
+      REQUIRE_THROWS_AS(make({ 8, 64, ESplitTrigger::areaRatio, areaRatio }), std::invalid_argument);
+    REQUIRE_THROWS_AS(make({ 8, 64, ESplitTrigger::countThreshold, 0.0625f, 0.5f }), std::invalid_argument);
+    REQUIRE_NOTHROW(make({ 8, 64, ESplitTrigger::areaRatio, 1.0f }));
+    REQUIRE_NOTHROW(make({ 1, 1, ESplitTrigger::eagerFit, 0.0625f, 1.0f }));
+  }
+}